@@ -18,6 +18,9 @@
 #define MSG_HEAD_TOTAL_LEN 4
 #define MSG_BODY_LENGTH 1024 * 2
 #define SEND_QUEUE_MAX_LEN 1000
+#define MSG_ID_MAX 2000
+// 接收环的大小，必须是2的幂
+#define RECV_RING_SIZE 1024 * 8
 
 enum class MsgType : std::uint16_t {
   MSG_HELLO_WORLD = 1001,
@@ -0,0 +1,66 @@
+#include "FrameParser.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+#include <boost/asio/detail/socket_ops.hpp>
+
+namespace core {
+
+std::pair<char *, std::size_t> FrameParser::Prepare() {
+  const std::size_t free_space = RING_SIZE - Readable();
+  const std::size_t pos = static_cast<std::size_t>(_write) & RING_MASK;
+  return {_ring.data() + pos, std::min(free_space, RING_SIZE - pos)};
+}
+
+void FrameParser::Commit(std::size_t bytes) {
+  _write += bytes;
+}
+
+void FrameParser::copyOut(std::uint64_t pos, char *dst, std::size_t len) const {
+  const std::size_t start = static_cast<std::size_t>(pos) & RING_MASK;
+  const std::size_t first = std::min(len, RING_SIZE - start);
+  memcpy(dst, _ring.data() + start, first);
+  memcpy(dst + first, _ring.data(), len - first);
+}
+
+ParseResult FrameParser::Next(FrameView &frame) {
+  if (Readable() < MSG_HEAD_TOTAL_LEN) {
+    return ParseResult::NEED_MORE;
+  }
+
+  // 头部只有4字节，直接拷到栈上解析，不区分是否回绕
+  std::array<char, MSG_HEAD_TOTAL_LEN> head;
+  copyOut(_read, head.data(), MSG_HEAD_TOTAL_LEN);
+
+  u_short data_id = 0;
+  u_short data_len = 0;
+  memcpy(&data_id, head.data(), MSG_TYPE_LENGTH);
+  memcpy(&data_len, head.data() + MSG_TYPE_LENGTH, MSG_LEN_LENGTH);
+  data_id = boost::asio::detail::socket_ops::network_to_host_short(data_id);
+  data_len = boost::asio::detail::socket_ops::network_to_host_short(data_len);
+
+  if (data_id > MSG_ID_MAX || data_len > MSG_BODY_LENGTH) {
+    return ParseResult::ERROR;
+  }
+
+  if (Readable() < static_cast<std::size_t>(MSG_HEAD_TOTAL_LEN) + data_len) {
+    return ParseResult::NEED_MORE;
+  }
+
+  const std::uint64_t body = _read + MSG_HEAD_TOTAL_LEN;
+  const std::size_t start = static_cast<std::size_t>(body) & RING_MASK;
+  if (start + data_len <= RING_SIZE) {
+    frame._data = _ring.data() + start;
+  } else {
+    copyOut(body, _spill.data(), data_len);
+    frame._data = _spill.data();
+  }
+
+  frame._id = static_cast<short>(data_id);
+  frame._len = static_cast<short>(data_len);
+  _read = body + data_len;
+  return ParseResult::FRAME;
+}
+
+} // namespace core
@@ -0,0 +1,69 @@
+#ifndef FRAMEPARSER_HPP
+#define FRAMEPARSER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <global/Global.hpp>
+#include <core/CoreExport.hpp>
+
+namespace core {
+
+// 一帧消息的视图，_data指向环形缓冲区内部或解析器的拼接区，在下一次Prepare之前有效
+struct CORE_EXPORT FrameView {
+  short _id{};
+  short _len{};
+  const char *_data{};
+};
+
+enum class ParseResult : std::uint8_t {
+  FRAME,      // 解析出一帧
+  NEED_MORE,  // 数据不足，需要继续读取
+  ERROR       // 非法头部，应关闭连接
+};
+
+/**
+  * @brief 增量式的分帧状态机，直接在接收环上原地解析，不做任何堆分配
+  *        只有当一帧跨越环的回绕点时，才会拷贝到内部的拼接区
+  **/
+class CORE_EXPORT FrameParser {
+public:
+  FrameParser() = default;
+
+  FrameParser(const FrameParser &) = delete;
+  FrameParser &operator=(const FrameParser &) = delete;
+
+  // 下一次async_read_some可写入的连续空间
+  [[nodiscard]] std::pair<char *, std::size_t> Prepare();
+
+  // 告知解析器实际读到了多少字节
+  void Commit(std::size_t bytes);
+
+  // 尝试解析下一帧，成功时消费该帧占用的字节
+  ParseResult Next(FrameView &frame);
+
+  [[nodiscard]] std::size_t Readable() const { return static_cast<std::size_t>(_write - _read); }
+
+private:
+  // 从逻辑偏移处拷贝len字节，处理回绕
+  void copyOut(std::uint64_t pos, char *dst, std::size_t len) const;
+
+  // 环的大小必须是2的幂，且放得下一整帧加上下一帧的头部
+  static constexpr std::size_t RING_SIZE = RECV_RING_SIZE;
+  static constexpr std::size_t RING_MASK = RING_SIZE - 1;
+  static_assert((RING_SIZE & RING_MASK) == 0, "RECV_RING_SIZE must be a power of two");
+  static_assert(RING_SIZE >= 2 * (MSG_HEAD_TOTAL_LEN + MSG_BODY_LENGTH), "RECV_RING_SIZE is too small");
+
+  std::array<char, RING_SIZE> _ring;
+  std::array<char, MSG_BODY_LENGTH> _spill;
+
+  // 单调递增的读写位置，取模后才是环内下标
+  std::uint64_t _read{0};
+  std::uint64_t _write{0};
+};
+
+} // namespace core
+
+#endif // FRAMEPARSER_HPP
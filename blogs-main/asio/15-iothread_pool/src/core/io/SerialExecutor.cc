@@ -0,0 +1,92 @@
+#include "SerialExecutor.hpp"
+
+#include <thread>
+
+#include <boost/asio/post.hpp>
+
+namespace core {
+
+// 一次最多连续执行的任务数，超过后重新投递，避免一个繁忙会话霸占io线程
+static constexpr int SERIAL_BATCH_SIZE = 32;
+
+SerialExecutor::SerialExecutor(boost::asio::io_context &ioc)
+  : _ioc(ioc), _head(&_stub), _tail(&_stub) {}
+
+SerialExecutor::~SerialExecutor() {
+  while (TaskBase *task = pop()) {
+    delete task;
+  }
+}
+
+void SerialExecutor::enqueue(TaskBase *task) {
+  task->_next.store(nullptr, std::memory_order_relaxed);
+  TaskBase *prev = _head.exchange(task, std::memory_order_acq_rel);
+  prev->_next.store(task, std::memory_order_release);
+}
+
+bool SerialExecutor::push(TaskBase *task) {
+  enqueue(task);
+  return _pending.fetch_add(1, std::memory_order_acq_rel) == 0;
+}
+
+SerialExecutor::TaskBase *SerialExecutor::pop() {
+  TaskBase *tail = _tail;
+  TaskBase *next = tail->_next.load(std::memory_order_acquire);
+
+  if (tail == &_stub) {
+    if (next == nullptr) {
+      return nullptr;
+    }
+    _tail = next;
+    tail = next;
+    next = next->_next.load(std::memory_order_acquire);
+  }
+
+  if (next != nullptr) {
+    _tail = next;
+    return tail;
+  }
+
+  // 生产者交换了_head但还没链接上_next，稍后重试
+  if (tail != _head.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+
+  enqueue(&_stub);
+  next = tail->_next.load(std::memory_order_acquire);
+  if (next != nullptr) {
+    _tail = next;
+    return tail;
+  }
+  return nullptr;
+}
+
+void SerialExecutor::schedule() {
+  boost::asio::post(_ioc, [self = shared_from_this()]() -> void {
+    self->drain();
+  });
+}
+
+void SerialExecutor::drain() {
+  // 执行过程中可能释放最后一个持有者，先持有自身
+  auto self = shared_from_this();
+
+  for (int i = 0; i < SERIAL_BATCH_SIZE; ++i) {
+    TaskBase *task = nullptr;
+    while ((task = pop()) == nullptr) {
+      std::this_thread::yield();
+    }
+
+    task->run();
+    delete task;
+
+    if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      return;
+    }
+  }
+
+  // 还有剩余任务，执行权保留，交给io_context稍后继续
+  schedule();
+}
+
+} // namespace core
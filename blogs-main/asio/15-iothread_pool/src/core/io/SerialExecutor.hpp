@@ -0,0 +1,87 @@
+#ifndef SERIALEXECUTOR_HPP
+#define SERIALEXECUTOR_HPP
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include <boost/asio/io_context.hpp>
+
+#include <core/CoreExport.hpp>
+
+namespace core {
+
+/**
+  * @brief 每个会话一个的串行执行器，保证同一会话的处理函数不会并发执行
+  *        任务挂在侵入式的无锁MPSC队列上，队列由空变非空的那个线程负责调度，
+  *        共享io_context的多个线程中同一时刻只有一个在消费该队列
+  **/
+class CORE_EXPORT SerialExecutor : public std::enable_shared_from_this<SerialExecutor> {
+public:
+  explicit SerialExecutor(boost::asio::io_context &ioc);
+  ~SerialExecutor();
+
+  SerialExecutor(const SerialExecutor &) = delete;
+  SerialExecutor &operator=(const SerialExecutor &) = delete;
+
+  // 总是经由io_context调度，可在任意线程调用
+  template <typename Fn>
+  void Post(Fn &&func) {
+    if (push(new Task<std::decay_t<Fn>>(std::forward<Fn>(func)))) {
+      schedule();
+    }
+  }
+
+  // 队列空闲时在当前线程直接执行，只应在io线程上调用(如异步操作的完成回调)
+  template <typename Fn>
+  void Dispatch(Fn &&func) {
+    if (push(new Task<std::decay_t<Fn>>(std::forward<Fn>(func)))) {
+      drain();
+    }
+  }
+
+private:
+  struct TaskBase {
+    virtual ~TaskBase() = default;
+    virtual void run() = 0;
+
+    std::atomic<TaskBase *> _next{nullptr};
+  };
+
+  template <typename Fn>
+  struct Task final : TaskBase {
+    explicit Task(Fn func) : _func(std::move(func)) {}
+    void run() override { _func(); }
+
+    Fn _func;
+  };
+
+  // 空的占位节点
+  struct Stub final : TaskBase {
+    void run() override {}
+  };
+
+  // 入队，返回true表示队列此前为空，调用方获得执行权
+  bool push(TaskBase *task);
+  TaskBase *pop();
+
+  void enqueue(TaskBase *task);
+  void schedule();
+  void drain();
+
+  boost::asio::io_context &_ioc;
+
+  // Vyukov式侵入队列: 生产者交换_head，消费者独占_tail
+  Stub _stub;
+  std::atomic<TaskBase *> _head;
+  TaskBase *_tail;
+
+  // 已入队未执行的任务数
+  std::atomic<std::size_t> _pending{0};
+};
+
+} // namespace core
+
+#endif // SERIALEXECUTOR_HPP
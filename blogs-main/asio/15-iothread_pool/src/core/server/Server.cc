@@ -19,7 +19,7 @@ Server::Server(boost::asio::io_context &ioc, unsigned short port)
 
 void Server::start_accept() {
   auto &ioc = ioPool.getIOContext();
-  auto new_sess = std::make_shared<Session>(ioc, this);
+  auto new_sess = Session::Create(ioc, this);
   _accep.async_accept(new_sess->getSocket(), [this, new_sess](boost::system::error_code err) -> void {
     handle_accept(new_sess, err);
   });
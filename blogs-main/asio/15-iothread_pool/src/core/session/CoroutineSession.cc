@@ -0,0 +1,79 @@
+#include "CoroutineSession.hpp"
+
+#include <memory>
+#include <cstddef>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/redirect_error.hpp>
+
+#include <middleware/Logger.hpp>
+#include <core/msg-node/MsgNode.hpp>
+
+namespace core {
+
+CoroutineSession::CoroutineSession(boost::asio::io_context& ioc, Server* server)
+    : Session(ioc, server), _strand(boost::asio::make_strand(ioc)), _send_signal(_strand) {}
+
+void CoroutineSession::Start() {
+  auto self = shared_self<CoroutineSession>();
+  boost::asio::co_spawn(_strand, [self]() -> boost::asio::awaitable<void> { co_await self->reader(); }, boost::asio::detached);
+  boost::asio::co_spawn(_strand, [self]() -> boost::asio::awaitable<void> { co_await self->writer(); }, boost::asio::detached);
+}
+
+void CoroutineSession::Send(short msg_id, short msg_len, const char *data) {
+  std::shared_ptr<MsgNode> node = std::make_shared<SendNode>(msg_id, msg_len, data);
+  boost::asio::post(_strand, [self = shared_self<CoroutineSession>(), node]() -> void { self->enqueue_signal(node); });
+}
+
+void CoroutineSession::on_close() {
+  _send_signal.cancel();
+}
+
+boost::asio::awaitable<void> CoroutineSession::reader() {
+  boost::system::error_code err;
+  while (!_is_closed.load(std::memory_order_acquire)) {
+    auto [buf, len] = _parser.Prepare();
+    std::size_t bytes_transferred = co_await _sock.async_read_some(boost::asio::buffer(buf, len),
+                                                                   boost::asio::redirect_error(boost::asio::use_awaitable, err));
+    if (!consume(err, bytes_transferred)) {
+      co_return;
+    }
+  }
+}
+
+// 只在strand上访问发送队列
+void CoroutineSession::enqueue_signal(const std::shared_ptr<MsgNode> &node) {
+  if (_send_queue.size() >= SEND_QUEUE_MAX_LEN) {
+    logger.error("the send queue is too long, don't push new bag");
+    return;
+  }
+  _send_queue.emplace(node);
+  _send_signal.cancel();
+}
+
+boost::asio::awaitable<void> CoroutineSession::writer() {
+  boost::system::error_code err;
+  while (!_is_closed.load(std::memory_order_acquire)) {
+    if (_send_queue.empty()) {
+      _send_signal.expires_at(boost::asio::steady_timer::time_point::max());
+      co_await _send_signal.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, err));
+      continue;
+    }
+
+    auto node = _send_queue.front();
+    co_await boost::asio::async_write(_sock, boost::asio::buffer(node->_data, static_cast<size_t>(node->_msg_len)),
+                                      boost::asio::redirect_error(boost::asio::use_awaitable, err));
+    if (err) {
+      logger.error("write error, err msg is: {}", err.message());
+      Close();
+      co_return;
+    }
+    _send_queue.pop();
+  }
+}
+
+} // namespace core
@@ -0,0 +1,40 @@
+#ifndef COROUTINESESSION_HPP
+#define COROUTINESESSION_HPP
+
+#include <memory>
+#include <utility>
+
+#include <boost/asio/strand.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <core/CoreExport.hpp>
+#include <core/session/Session.hpp>
+
+namespace core {
+
+// 协程模型: 读写各一个协程，都跑在会话的strand上，发送队列无需加锁，ExecMode不生效
+class CORE_EXPORT CoroutineSession final : public Session {
+public:
+  CoroutineSession(boost::asio::io_context& ioc, Server* server);
+
+  void Start() override;
+  void Send(short msg_id, short msg_len, const char *data) override;
+
+private:
+  void on_close() override;
+
+  boost::asio::awaitable<void> reader();
+  boost::asio::awaitable<void> writer();
+  void enqueue_signal(const std::shared_ptr<MsgNode> &node);
+
+  boost::asio::strand<boost::asio::io_context::executor_type> _strand;
+
+  // 发送队列空时写协程挂在这里，入队或关闭时唤醒
+  boost::asio::steady_timer _send_signal;
+};
+
+} // namespace core
+
+#endif // COROUTINESESSION_HPP
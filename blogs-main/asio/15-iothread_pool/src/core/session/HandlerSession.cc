@@ -0,0 +1,108 @@
+#include "HandlerSession.hpp"
+
+#include <memory>
+#include <cstddef>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/write.hpp>
+
+#include <middleware/Logger.hpp>
+#include <core/msg-node/MsgNode.hpp>
+
+namespace core {
+
+HandlerSession::HandlerSession(boost::asio::io_context& ioc, Server* server)
+    : Session(ioc, server), _strand(boost::asio::make_strand(ioc)), _serial(std::make_shared<SerialExecutor>(ioc)) {}
+
+void HandlerSession::Start() {
+  do_read();
+}
+
+void HandlerSession::do_read() {
+  auto [buf, len] = _parser.Prepare();
+  _sock.async_read_some(boost::asio::buffer(buf, len),
+    [self = shared_self<HandlerSession>()](const boost::system::error_code &err, std::size_t bytes_transferred) -> void {
+      self->run_serialized([self, err, bytes_transferred]() -> void {
+        self->handle_read(err, bytes_transferred);
+      });
+    }
+  );
+}
+
+void HandlerSession::Send(short msg_id, short msg_len, const char *data) {
+  std::shared_ptr<MsgNode> node = std::make_shared<SendNode>(msg_id, msg_len, data);
+
+  // Send通常由逻辑线程调用，串行化模式下投递到会话的执行器上再操作发送队列
+  switch (_exec_mode) {
+    case ExecMode::STRAND:
+      boost::asio::post(_strand, [self = shared_self<HandlerSession>(), node]() -> void { self->do_send(node); });
+      break;
+    case ExecMode::SERIAL:
+      _serial->Post([self = shared_self<HandlerSession>(), node]() -> void { self->do_send(node); });
+      break;
+    default:
+      do_send(node);
+      break;
+  }
+}
+
+void HandlerSession::do_send(const std::shared_ptr<MsgNode> &node) {
+  bool pending = false;
+
+  {
+    std::unique_lock<std::mutex> lock{_send_mtx, std::defer_lock};
+    if (_exec_mode == ExecMode::MUTEX) {
+      lock.lock();
+    }
+    pending = _send_queue.empty();
+    if (_send_queue.size() >= SEND_QUEUE_MAX_LEN){
+      logger.error("the send queue is too long, don't push new bag");
+      return;
+    }
+    _send_queue.emplace(node);
+  }
+
+  if (!pending) {
+    return;
+  }
+
+  auto& msg_node = _send_queue.front();
+  boost::asio::async_write(_sock, boost::asio::buffer(msg_node->_data, static_cast<size_t>(msg_node->_msg_len)),
+    [self = shared_self<HandlerSession>()](const boost::system::error_code& errc, size_t) -> void {
+      self->run_serialized([self, errc]() -> void {
+        self->handle_write(errc);
+      });
+    }
+  );
+}
+
+void HandlerSession::handle_read(const boost::system::error_code &err, std::size_t bytes_transferred) {
+  if (consume(err, bytes_transferred)) {
+    do_read();
+  }
+}
+
+void HandlerSession::handle_write(const boost::system::error_code& err) {
+  if (!err) {
+    std::unique_lock<std::mutex> lock{_send_mtx, std::defer_lock};
+    if (_exec_mode == ExecMode::MUTEX) {
+      lock.lock();
+    }
+    _send_queue.pop();
+    if (!_send_queue.empty()) {
+      auto& node =_send_queue.front();
+      boost::asio::async_write(_sock, boost::asio::buffer(node->_data, static_cast<size_t>(node->_msg_len)),
+        [self = shared_self<HandlerSession>()](const boost::system::error_code& errc, size_t) -> void {
+          self->run_serialized([self, errc]() -> void {
+            self->handle_write(errc);
+          });
+        }
+      );
+    }
+  } else {
+    logger.error("write error, err msg is: {}", err.message());
+    Close();
+  }
+}
+
+} // namespace core
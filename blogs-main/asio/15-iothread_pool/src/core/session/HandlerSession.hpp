@@ -0,0 +1,53 @@
+#ifndef HANDLERSESSION_HPP
+#define HANDLERSESSION_HPP
+
+#include <mutex>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+#include <boost/asio/strand.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/system/detail/error_code.hpp>
+
+#include <core/CoreExport.hpp>
+#include <core/session/Session.hpp>
+#include <core/io/SerialExecutor.hpp>
+
+namespace core {
+
+// 回调链模型: 每次读写完成都回到handle_read/handle_write，再发起下一次
+class CORE_EXPORT HandlerSession final : public Session {
+public:
+  HandlerSession(boost::asio::io_context& ioc, Server* server);
+
+  void Start() override;
+  void Send(short msg_id, short msg_len, const char *data) override;
+
+private:
+  // io线程上的完成回调经由此处串行化，MUTEX模式下直接执行
+  template <typename Fn>
+  void run_serialized(Fn &&func) {
+    switch (_exec_mode) {
+      case ExecMode::STRAND: boost::asio::dispatch(_strand, std::forward<Fn>(func)); break;
+      case ExecMode::SERIAL: _serial->Dispatch(std::forward<Fn>(func)); break;
+      default:               func(); break;
+    }
+  }
+
+  void do_read();
+  void do_send(const std::shared_ptr<MsgNode> &node);
+  void handle_read(const boost::system::error_code& err, std::size_t bytes_transferred);
+  void handle_write(const boost::system::error_code& err);
+
+  boost::asio::strand<boost::asio::io_context::executor_type> _strand;
+  std::shared_ptr<SerialExecutor> _serial;
+
+  // 只有MUTEX模式需要加锁
+  std::mutex _send_mtx;
+};
+
+} // namespace core
+
+#endif // HANDLERSESSION_HPP
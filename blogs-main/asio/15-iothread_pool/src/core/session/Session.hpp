@@ -1,67 +1,97 @@
 #ifndef SESSION_HPP
 #define SESSION_HPP
 
-#include <array>
 #include <atomic>
-#include <mutex>
 #include <queue>
 #include <memory>
+#include <string>
 #include <cstddef>
+#include <cstdint>
 
 #include <boost/asio/ip/tcp.hpp>
-#include <boost/uuid/uuid_io.hpp>
 #include <boost/asio/io_context.hpp>
-#include <boost/uuid/uuid_generators.hpp>
-#include <boost/uuid/random_generator.hpp>
 #include <boost/system/detail/error_code.hpp>
 
 #include <core/CoreExport.hpp>
 #include <global/Global.hpp>
+#include <core/frame/FrameParser.hpp>
 
 namespace core {
 
 class Server;
 class MsgNode;
+
+// 共享io_context时，同一会话的读写回调的串行化方式，只对回调模型生效
+enum class ExecMode : std::uint8_t {
+  MUTEX,   // 回调可能并发执行，发送队列加锁保护
+  STRAND,  // 回调经由asio的strand串行化
+  SERIAL   // 回调经由会话自己的SerialExecutor串行化
+};
+
+// 会话的IO模型，启动时选定，之后创建的会话都使用该模型
+enum class IoModel : std::uint8_t {
+  HANDLER,   // 回调链: async_read_some -> handle_read -> do_read，见HandlerSession
+  COROUTINE  // 协程: 读写各一个协程，运行在会话的strand上，见CoroutineSession
+};
+
+/**
+  * @brief 会话的统一接口，Server与LogicSystem只通过它与连接打交道
+  * @details 分帧、收包后投递逻辑线程、发送节点与会话管理都在基类中完成，两种模型的线上格式完全一致；
+  *          子类只决定读写如何发起: HandlerSession是4~15一路沿用的回调链，CoroutineSession是17的协程写法
+  **/
 class CORE_EXPORT Session : public std::enable_shared_from_this<Session> {
 public:
-  Session(boost::asio::io_context& ioc, Server* server) : _sock(ioc), _server(server) {
-    boost::uuids::uuid uuid = boost::uuids::random_generator_mt19937()();
-    _uuid = boost::uuids::to_string(uuid);
-  }
+  virtual ~Session() = default;
 
   Session(const Session&) = delete;
   Session& operator=(const Session&) = delete;
 
-  void Start();
+  // 按SetIoModel选定的模型创建会话
+  static std::shared_ptr<Session> Create(boost::asio::io_context& ioc, Server* server);
+
+  virtual void Start() = 0;
+  virtual void Send(short msg_id, short msg_len, const char *data) = 0;
   void Close();
-  void Send(short msg_id, short msg_len, const char *data);
+
+  // 需在服务器开始接收连接前设置
+  static void SetExecMode(ExecMode mode) { _exec_mode = mode; }
+  static void SetIoModel(IoModel model) { _io_model = model; }
 
   boost::asio::ip::tcp::socket& getSocket() { return _sock; }
   std::string getUUid() { return _uuid; }
 
-private:
-  void handle_read(const boost::system::error_code& err, std::size_t bytes_transferred);
-  void handle_write(const boost::system::error_code& err);
+protected:
+  Session(boost::asio::io_context& ioc, Server* server);
+
+  // 两种模型共用的收包逻辑，返回false表示会话已关闭
+  bool consume(const boost::system::error_code& err, std::size_t bytes_transferred);
+
+  // 关闭时由Close调用一次，子类在这里唤醒自己挂起的等待
+  virtual void on_close() {}
+
+  template <typename Derived>
+  std::shared_ptr<Derived> shared_self() {
+    return std::static_pointer_cast<Derived>(shared_from_this());
+  }
 
   boost::asio::ip::tcp::socket _sock;
-  std::array<char, MSG_BODY_LENGTH> _data;
   std::atomic_bool _is_closed{false};
 
+  inline static ExecMode _exec_mode{ExecMode::MUTEX};
+  inline static IoModel _io_model{IoModel::HANDLER};
+
   // 服务器管理会话使用
   Server *_server;
   std::string _uuid;
 
-  // 发送队列
+  // 发送队列，由子类决定如何保护
   std::queue<std::shared_ptr<MsgNode>> _send_queue;
-  std::mutex _send_mtx;
 
-  // 接收节点的处理
-  std::shared_ptr<MsgNode> _recv_head_node;
-  std::shared_ptr<MsgNode> _recv_msg_node;
-  std::atomic_bool _head_parse{false};
+  // 接收环与分帧状态
+  FrameParser _parser;
 };
 
 } // namespace core
 
 
-#endif // SESSION_HPP
\ No newline at end of file
+#endif // SESSION_HPP
@@ -1,12 +1,30 @@
 #include <middleware/Logger.hpp>
 #include <core/server/Server.hpp>
+#include <core/session/Session.hpp>
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/system/detail/error_code.hpp>
 
-int main() {
+#include <string_view>
+
+// 用法: server [mutex|strand|serial] [callback|coroutine]
+// 第一个参数选择回调的串行化方式，第二个参数选择会话的IO模型
+int main(int argc, char *argv[]) {
   try {
+    std::string_view mode = argc > 1 ? argv[1] : "mutex";
+    if (mode == "strand") {
+      core::Session::SetExecMode(core::ExecMode::STRAND);
+    } else if (mode == "serial") {
+      core::Session::SetExecMode(core::ExecMode::SERIAL);
+    }
+
+    std::string_view model = argc > 2 ? argv[2] : "callback";
+    if (model == "coroutine") {
+      core::Session::SetIoModel(core::IoModel::COROUTINE);
+    }
+    logger.info("Session exec mode: {}, io model: {}", mode, model);
+
     boost::asio::io_context ioc;
 
     boost::asio::signal_set signals(ioc, SIGINT, SIGTERM);
@@ -0,0 +1,109 @@
+#include <core/io/SerialExecutor.hpp>
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 共享io_context下三种会话串行化方式的对比: 加锁、asio strand、SerialExecutor
+// 若干生产者线程(模拟逻辑线程调用Send)向随机会话投递小任务，io线程数逐步增加
+
+constexpr int SESSION_COUNT = 256;
+constexpr int PRODUCER_COUNT = 4;
+constexpr int TASKS_PER_PRODUCER = 250000;
+
+struct BenchSession {
+  explicit BenchSession(boost::asio::io_context &ioc)
+    : _strand(boost::asio::make_strand(ioc)), _serial(std::make_shared<core::SerialExecutor>(ioc)) {}
+
+  // 任务体: 检测是否有并发进入，然后做一点计算
+  void work(std::atomic<int> &done) {
+    if (_inside.exchange(true, std::memory_order_acquire)) {
+      std::cout << "concurrent execution detected!\n";
+      std::exit(1);
+    }
+    for (int i = 0; i < 64; ++i) {
+      _counter = _counter * 31 + static_cast<unsigned>(i);
+    }
+    _inside.store(false, std::memory_order_release);
+    done.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::mutex _mtx;
+  boost::asio::strand<boost::asio::io_context::executor_type> _strand;
+  std::shared_ptr<core::SerialExecutor> _serial;
+  std::atomic_bool _inside{false};
+  unsigned _counter{0};
+};
+
+double run(const std::string &mode, unsigned thread_count) {
+  boost::asio::io_context ioc;
+  auto guard = boost::asio::make_work_guard(ioc);
+  std::vector<std::unique_ptr<BenchSession>> sessions;
+  for (int i = 0; i < SESSION_COUNT; ++i) {
+    sessions.emplace_back(std::make_unique<BenchSession>(ioc));
+  }
+
+  std::atomic<int> done{0};
+  const int total = PRODUCER_COUNT * TASKS_PER_PRODUCER;
+
+  std::vector<std::jthread> io_threads;
+  for (unsigned i = 0; i < thread_count; ++i) {
+    io_threads.emplace_back([&ioc]() -> void { ioc.run(); });
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::jthread> producers;
+  for (int p = 0; p < PRODUCER_COUNT; ++p) {
+    producers.emplace_back([&, p]() -> void {
+      unsigned seed = static_cast<unsigned>(p) * 2654435761U + 1U;
+      for (int i = 0; i < TASKS_PER_PRODUCER; ++i) {
+        seed = seed * 1664525U + 1013904223U;
+        auto &sess = *sessions[seed % SESSION_COUNT];
+        if (mode == "mutex") {
+          boost::asio::post(ioc, [&sess, &done]() -> void {
+            std::scoped_lock<std::mutex> lock{sess._mtx};
+            sess.work(done);
+          });
+        } else if (mode == "strand") {
+          boost::asio::post(sess._strand, [&sess, &done]() -> void { sess.work(done); });
+        } else {
+          sess._serial->Post([&sess, &done]() -> void { sess.work(done); });
+        }
+      }
+    });
+  }
+  producers.clear();
+
+  while (done.load(std::memory_order_relaxed) < total) {
+    std::this_thread::yield();
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  guard.reset();
+  ioc.stop();
+  io_threads.clear();
+  return static_cast<double>(total) / seconds / 1e6;
+}
+
+int main() {
+  const unsigned thread_counts[] = {1, 2, 4, 8, 16, 32};
+  std::cout << "threads\tmutex\tstrand\tserial   (Mtasks/s)\n";
+  for (auto threads : thread_counts) {
+    std::cout << threads;
+    for (const char *mode : {"mutex", "strand", "serial"}) {
+      std::cout << '\t' << run(mode, threads);
+    }
+    std::cout << '\n';
+  }
+}
@@ -0,0 +1,127 @@
+#include <core/frame/FrameParser.hpp>
+
+#include <boost/asio/detail/socket_ops.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+// 分帧吞吐量的微基准: 对比旧handle_read的拷贝方式与新的原地解析
+// coalesced: 每次读取都是满缓冲区，包含多帧; fragmented: 每次读取只有1~7字节
+
+std::string buildStream(std::size_t frames, std::size_t body_len) {
+  std::string body(body_len, 'x');
+  auto net_id = boost::asio::detail::socket_ops::host_to_network_short(static_cast<u_short>(1001));
+  auto net_len = boost::asio::detail::socket_ops::host_to_network_short(static_cast<u_short>(body_len));
+  std::string stream;
+  stream.reserve(frames * (body_len + MSG_HEAD_TOTAL_LEN));
+  for (std::size_t i = 0; i < frames; ++i) {
+    stream.append(reinterpret_cast<const char *>(&net_id), MSG_TYPE_LENGTH);
+    stream.append(reinterpret_cast<const char *>(&net_len), MSG_LEN_LENGTH);
+    stream.append(body);
+  }
+  return stream;
+}
+
+// 模拟旧实现: 每次读取前memset 2KB，头部和消息体各拷贝一次，每帧make_shared一个节点
+std::size_t legacyParse(const std::string &stream, std::size_t max_chunk, std::mt19937 &rng) {
+  struct Node {
+    explicit Node(std::size_t len) : _data(new char[len + 1]()), _len(len) {}
+    ~Node() { delete[] _data; }
+    char *_data;
+    std::size_t _len;
+    std::size_t _cur{0};
+  };
+
+  std::array<char, MSG_BODY_LENGTH> data;
+  std::array<char, MSG_HEAD_TOTAL_LEN> head{};
+  std::size_t head_cur = 0;
+  std::shared_ptr<Node> node;
+  std::size_t frames = 0;
+  std::uniform_int_distribution<std::size_t> chunk_dist(1, max_chunk);
+
+  for (std::size_t offset = 0; offset < stream.size();) {
+    memset(data.data(), 0, data.size());
+    std::size_t bytes = std::min({chunk_dist(rng), data.size(), stream.size() - offset});
+    memcpy(data.data(), stream.data() + offset, bytes);
+    offset += bytes;
+
+    std::size_t pos = 0;
+    while (pos < bytes) {
+      if (!node) {
+        std::size_t take = std::min(MSG_HEAD_TOTAL_LEN - head_cur, bytes - pos);
+        memcpy(head.data() + head_cur, data.data() + pos, take);
+        head_cur += take;
+        pos += take;
+        if (head_cur < MSG_HEAD_TOTAL_LEN) {
+          break;
+        }
+        u_short len = 0;
+        memcpy(&len, head.data() + MSG_TYPE_LENGTH, MSG_LEN_LENGTH);
+        node = std::make_shared<Node>(boost::asio::detail::socket_ops::network_to_host_short(len));
+        head_cur = 0;
+      }
+      std::size_t take = std::min(node->_len - node->_cur, bytes - pos);
+      memcpy(node->_data + node->_cur, data.data() + pos, take);
+      node->_cur += take;
+      pos += take;
+      if (node->_cur == node->_len) {
+        auto delivered = std::make_shared<Node>(node->_len);
+        memcpy(delivered->_data, node->_data, node->_len);
+        node.reset();
+        ++frames;
+      }
+    }
+  }
+  return frames;
+}
+
+// 只计解析本身，不含Session投递给逻辑线程前的那一次拷贝
+std::size_t ringParse(const std::string &stream, std::size_t max_chunk, std::mt19937 &rng) {
+  auto parser = std::make_unique<core::FrameParser>();
+  std::uniform_int_distribution<std::size_t> chunk_dist(1, max_chunk);
+  std::size_t frames = 0;
+  std::size_t checksum = 0;
+
+  for (std::size_t offset = 0; offset < stream.size();) {
+    auto [buf, len] = parser->Prepare();
+    std::size_t bytes = std::min({chunk_dist(rng), len, stream.size() - offset});
+    memcpy(buf, stream.data() + offset, bytes);
+    parser->Commit(bytes);
+    offset += bytes;
+
+    core::FrameView view;
+    while (parser->Next(view) == core::ParseResult::FRAME) {
+      checksum += static_cast<unsigned char>(view._data[0]);
+      ++frames;
+    }
+  }
+  return checksum == 0 ? 0 : frames;
+}
+
+template <typename Fn>
+void run(const char *name, const std::string &stream, std::size_t max_chunk, Fn &&parse) {
+  std::mt19937 rng{42};
+  auto start = std::chrono::steady_clock::now();
+  std::size_t frames = parse(stream, max_chunk, rng);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << name << ": " << frames << " frames, "
+            << static_cast<double>(frames) / seconds / 1e6 << " Mframes/s, "
+            << static_cast<double>(stream.size()) / seconds / (1024.0 * 1024.0) << " MB/s\n";
+}
+
+int main() {
+  const std::size_t body_sizes[] = {32, 512, 2000};
+  for (auto body_len : body_sizes) {
+    std::string stream = buildStream((64U * 1024U * 1024U) / (body_len + MSG_HEAD_TOTAL_LEN), body_len);
+    std::cout << "== body " << body_len << " bytes\n";
+    run("legacy  coalesced ", stream, MSG_BODY_LENGTH, legacyParse);
+    run("ring    coalesced ", stream, MSG_BODY_LENGTH, ringParse);
+    run("legacy  fragmented", stream, 7, legacyParse);
+    run("ring    fragmented", stream, 7, ringParse);
+  }
+}
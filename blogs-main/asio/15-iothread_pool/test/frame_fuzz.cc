@@ -0,0 +1,117 @@
+#include <core/frame/FrameParser.hpp>
+
+#include <boost/asio/detail/socket_ops.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// 随机生成合法帧，按随机大小切片喂给解析器，校验解析结果与原始帧完全一致
+struct Frame {
+  short _id;
+  std::string _body;
+};
+
+std::string encode(const Frame &frame) {
+  auto net_id = boost::asio::detail::socket_ops::host_to_network_short(static_cast<u_short>(frame._id));
+  auto net_len = boost::asio::detail::socket_ops::host_to_network_short(static_cast<u_short>(frame._body.size()));
+  std::string out(MSG_HEAD_TOTAL_LEN, '\0');
+  memcpy(out.data(), &net_id, MSG_TYPE_LENGTH);
+  memcpy(out.data() + MSG_TYPE_LENGTH, &net_len, MSG_LEN_LENGTH);
+  return out + frame._body;
+}
+
+// 把stream按最多max_chunk的切片写入解析器，返回解析出的帧，遇到ERROR时置位error
+std::vector<Frame> feed(core::FrameParser &parser, const std::string &stream, std::mt19937 &rng, std::size_t max_chunk, bool &error) {
+  std::vector<Frame> out;
+  std::uniform_int_distribution<std::size_t> chunk_dist(1, max_chunk);
+  std::size_t offset = 0;
+  error = false;
+
+  while (offset < stream.size()) {
+    auto [buf, len] = parser.Prepare();
+    std::size_t chunk = std::min({chunk_dist(rng), len, stream.size() - offset});
+    memcpy(buf, stream.data() + offset, chunk);
+    parser.Commit(chunk);
+    offset += chunk;
+
+    core::FrameView view;
+    core::ParseResult result;
+    while ((result = parser.Next(view)) == core::ParseResult::FRAME) {
+      if (view._len < 0 || view._len > MSG_BODY_LENGTH) {
+        std::cout << "frame length out of range: " << view._len << '\n';
+        std::exit(1);
+      }
+      out.push_back({view._id, std::string(view._data, static_cast<std::size_t>(view._len))});
+    }
+    if (result == core::ParseResult::ERROR) {
+      error = true;
+      return out;
+    }
+  }
+  return out;
+}
+
+int main(int argc, char *argv[]) {
+  unsigned seed = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 20251019U;
+  int rounds = argc > 2 ? std::atoi(argv[2]) : 200;
+  std::mt19937 rng{seed};
+
+  std::uniform_int_distribution<int> id_dist(0, MSG_ID_MAX);
+  std::uniform_int_distribution<int> len_dist(0, MSG_BODY_LENGTH);
+  std::uniform_int_distribution<int> byte_dist(0, 255);
+  std::uniform_int_distribution<int> count_dist(1, 64);
+  const std::size_t chunk_sizes[] = {1, 3, 7, 64, 1500, 8192};
+
+  // 合法输入: 任意切分方式下都必须逐帧还原
+  for (int round = 0; round < rounds; ++round) {
+    std::vector<Frame> frames;
+    std::string stream;
+    int count = count_dist(rng);
+    for (int i = 0; i < count; ++i) {
+      Frame frame{static_cast<short>(id_dist(rng)), std::string(static_cast<std::size_t>(len_dist(rng) % (i % 4 == 0 ? MSG_BODY_LENGTH + 1 : 64)), '\0')};
+      for (auto &ch : frame._body) {
+        ch = static_cast<char>(byte_dist(rng));
+      }
+      stream += encode(frame);
+      frames.push_back(std::move(frame));
+    }
+
+    for (auto max_chunk : chunk_sizes) {
+      core::FrameParser parser;
+      bool error = false;
+      auto parsed = feed(parser, stream, rng, max_chunk, error);
+      if (error || parsed.size() != frames.size()) {
+        std::cout << "round " << round << " chunk " << max_chunk << ": expected " << frames.size() << " frames, got " << parsed.size() << '\n';
+        return 1;
+      }
+      for (std::size_t i = 0; i < frames.size(); ++i) {
+        if (parsed[i]._id != frames[i]._id || parsed[i]._body != frames[i]._body) {
+          std::cout << "round " << round << " chunk " << max_chunk << ": frame " << i << " mismatch\n";
+          return 1;
+        }
+      }
+      if (parser.Readable() != 0) {
+        std::cout << "round " << round << ": " << parser.Readable() << " bytes left over\n";
+        return 1;
+      }
+    }
+  }
+
+  // 随机垃圾输入: 不能越界，只能返回帧、NEED_MORE或ERROR
+  for (int round = 0; round < rounds; ++round) {
+    std::string garbage(static_cast<std::size_t>(len_dist(rng)) * 4, '\0');
+    for (auto &ch : garbage) {
+      ch = static_cast<char>(byte_dist(rng));
+    }
+    core::FrameParser parser;
+    bool error = false;
+    feed(parser, garbage, rng, 512, error);
+  }
+
+  std::cout << "frame fuzz passed, seed " << seed << ", rounds " << rounds << '\n';
+  return 0;
+}
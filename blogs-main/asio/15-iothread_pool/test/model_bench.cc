@@ -0,0 +1,200 @@
+#include <core/server/Server.hpp>
+#include <core/session/Session.hpp>
+#include <global/Global.hpp>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+// 回调栈与协程栈的同负载对比，每个服务端独占一个子进程，互不干扰:
+//   15-callback   本目录的Session接口 + HandlerSession(4~15一路沿用的回调链)
+//   15-coroutine  本目录的Session接口 + CoroutineSession
+//   17-coroutine  17-coroutine-server的完整协程栈，线上分帧相同，只走其基础帧格式
+// 用法: modelBench                               依次测量以上三个服务端
+//       modelBench serve <callback|coroutine>    以指定模型运行本目录的服务端，由驱动进程拉起
+
+#ifndef COROUTINE_SERVER_BIN
+#define COROUTINE_SERVER_BIN ""
+#endif
+
+// 两个栈的服务端都固定监听该端口，依次运行，不会冲突
+constexpr unsigned short BENCH_PORT = 10088;
+constexpr int CLIENT_COUNT = 16;
+constexpr int MESSAGES_PER_CLIENT = 2000;
+constexpr auto STARTUP_TIMEOUT = std::chrono::seconds(10);
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchResult {
+  double _msg_per_sec{};
+  double _p99_us{};
+  double _server_cpu_us_per_msg{};
+};
+
+std::string buildFrame(const std::string &body) {
+  std::string frame(MSG_HEAD_TOTAL_LEN, '\0');
+  auto msg_id = boost::asio::detail::socket_ops::host_to_network_short(static_cast<u_short>(MsgType::MSG_HELLO_WORLD));
+  auto msg_len = boost::asio::detail::socket_ops::host_to_network_short(static_cast<u_short>(body.size()));
+  memcpy(frame.data(), &msg_id, MSG_TYPE_LENGTH);
+  memcpy(frame.data() + MSG_TYPE_LENGTH, &msg_len, MSG_LEN_LENGTH);
+  return frame + body;
+}
+
+// 单连接的请求-响应往返，返回每条消息的延迟(微秒)
+std::vector<double> clientRun(int clientId) {
+  boost::asio::io_context ioc;
+  boost::asio::ip::tcp::socket sock{ioc};
+  sock.connect({boost::asio::ip::make_address_v4("127.0.0.1"), BENCH_PORT});
+  sock.set_option(boost::asio::ip::tcp::no_delay{true});
+
+  const std::string frame = buildFrame(R"({"data":"hello from bench client )" + std::to_string(clientId) +
+                                       R"(","id":)" + std::to_string(clientId) + R"(,"test":"test str"})");
+  std::array<char, MSG_HEAD_TOTAL_LEN + MSG_BODY_LENGTH> recv{};
+  std::vector<double> latencies;
+  latencies.reserve(MESSAGES_PER_CLIENT);
+
+  for (int i = 0; i < MESSAGES_PER_CLIENT; ++i) {
+    auto start = Clock::now();
+    boost::asio::write(sock, boost::asio::buffer(frame));
+    boost::asio::read(sock, boost::asio::buffer(recv.data(), MSG_HEAD_TOTAL_LEN));
+    u_short len = 0;
+    memcpy(&len, recv.data() + MSG_TYPE_LENGTH, MSG_LEN_LENGTH);
+    len = boost::asio::detail::socket_ops::network_to_host_short(len);
+    boost::asio::read(sock, boost::asio::buffer(recv.data(), len));
+    latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+  }
+  return latencies;
+}
+
+// 服务端起来之前连接会被拒绝，轮询直到能连上
+bool waitForServer() {
+  boost::asio::io_context ioc;
+  auto deadline = Clock::now() + STARTUP_TIMEOUT;
+  while (Clock::now() < deadline) {
+    boost::asio::ip::tcp::socket sock{ioc};
+    boost::system::error_code errc;
+    sock.connect({boost::asio::ip::make_address_v4("127.0.0.1"), BENCH_PORT}, errc);
+    if (!errc) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  return false;
+}
+
+// 服务端每条消息都会打日志，子进程的输出全部丢弃
+pid_t spawnServer(const std::vector<std::string> &args) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    int null_fd = open("/dev/null", O_WRONLY);
+    dup2(null_fd, STDOUT_FILENO);
+    dup2(null_fd, STDERR_FILENO);
+
+    std::vector<char *> argv;
+    for (const auto &arg : args) {
+      argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    execv(argv[0], argv.data());
+    _exit(127);
+  }
+  return pid;
+}
+
+bool runTarget(std::string_view label, const std::vector<std::string> &args, BenchResult &result) {
+  pid_t pid = spawnServer(args);
+  if (pid < 0 || !waitForServer()) {
+    std::cerr << label << ": server did not start\n";
+    if (pid > 0) {
+      kill(pid, SIGKILL);
+      waitpid(pid, nullptr, 0);
+    }
+    return false;
+  }
+
+  std::vector<double> latencies;
+  std::mutex result_mtx;
+  auto start = Clock::now();
+  {
+    std::vector<std::jthread> clients;
+    for (int i = 0; i < CLIENT_COUNT; ++i) {
+      clients.emplace_back([i, &latencies, &result_mtx]() -> void {
+        auto local = clientRun(i);
+        std::lock_guard<std::mutex> lock{result_mtx};
+        latencies.insert(latencies.end(), local.begin(), local.end());
+      });
+    }
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  // 子进程被杀掉后仍可经由wait4取得它用掉的CPU时间，启动开销相对整轮负载可以忽略
+  kill(pid, SIGKILL);
+  rusage usage{};
+  int status = 0;
+  wait4(pid, &status, 0, &usage);
+  double server_cpu = static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+                      static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+
+  std::sort(latencies.begin(), latencies.end());
+  auto total = static_cast<double>(latencies.size());
+  result._msg_per_sec = total / seconds;
+  result._p99_us = latencies[static_cast<std::size_t>(0.99 * (total - 1))];
+  result._server_cpu_us_per_msg = server_cpu / total * 1e6;
+  return true;
+}
+
+int serve(std::string_view model) {
+  core::Session::SetIoModel(model == "coroutine" ? core::IoModel::COROUTINE : core::IoModel::HANDLER);
+
+  boost::asio::io_context ioc;
+  core::Server server{ioc, BENCH_PORT};
+  ioc.run();
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 2 && std::string_view{argv[1]} == "serve") {
+    return serve(argv[2]);
+  }
+
+  std::vector<std::pair<std::string, std::vector<std::string>>> targets{
+    {"15-callback", {argv[0], "serve", "callback"}},
+    {"15-coroutine", {argv[0], "serve", "coroutine"}},
+  };
+  if (std::string_view{COROUTINE_SERVER_BIN}.empty() || access(COROUTINE_SERVER_BIN, X_OK) != 0) {
+    std::cerr << "17-coroutine-server not built, skipping it\n";
+  } else {
+    targets.push_back({"17-coroutine", {COROUTINE_SERVER_BIN}});
+  }
+
+  std::cout << "stack\tmsg/s\tp99(us)\tserver cpu/msg(us)\n";
+  for (const auto &[label, args] : targets) {
+    BenchResult result;
+    if (!runTarget(label, args, result)) {
+      return 1;
+    }
+    std::cout << label << '\t' << result._msg_per_sec << '\t' << result._p99_us << '\t'
+              << result._server_cpu_us_per_msg << '\n';
+  }
+  return 0;
+}
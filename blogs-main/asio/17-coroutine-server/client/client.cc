@@ -1,77 +1,139 @@
 #include <boost/asio.hpp>
-#include <boost/asio/ip/address.hpp>
+#include <boost/asio/use_future.hpp>
+
+#include <core/dns/DnsCache.hpp>
 
 #include <json/json.h>
 #include <json/reader.h>
 #include <json/value.h>
 #include <json/writer.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #define HEAD_LENGTH 2
+#define REQ_ID_LENGTH 4
+#define REQ_ID_FLAG 0x8000
 #define MAX_LENGTH 1024 * 2
 
-void clientThread(int threadId) {
+using Clock = std::chrono::steady_clock;
+
+// 所有线程的请求延迟，结束时统一计算分位数
+std::mutex latency_mtx;
+std::vector<double> latencies_us;
+
+// pipeline > 1 时每个请求带上请求id，不再要求写一条读一条
+std::string buildFrame(int threadId, int index, std::uint32_t reqId) {
+  Json::Value root;
+  root["test"] = "test str";
+  root["data"] = "hello from thread " + std::to_string(threadId) + " message " + std::to_string(index);
+  Json::StreamWriterBuilder builder;
+  std::string raw_str = Json::writeString(builder, root);
+
+  auto data_id = static_cast<u_short>(1001);
+  if (reqId != 0) {
+    data_id = static_cast<u_short>(data_id | REQ_ID_FLAG);
+  }
+  data_id = boost::asio::detail::socket_ops::host_to_network_short(data_id);
+  auto send_len = boost::asio::detail::socket_ops::host_to_network_short(static_cast<u_short>(raw_str.length()));
+
+  std::string frame(HEAD_LENGTH + HEAD_LENGTH, '\0');
+  memcpy(frame.data(), &data_id, HEAD_LENGTH);
+  memcpy(frame.data() + HEAD_LENGTH, &send_len, HEAD_LENGTH);
+  if (reqId != 0) {
+    auto net_req_id = static_cast<std::uint32_t>(boost::asio::detail::socket_ops::host_to_network_long(reqId));
+    frame.append(reinterpret_cast<const char *>(&net_req_id), REQ_ID_LENGTH);
+  }
+  frame.append(raw_str);
+  return frame;
+}
+
+// 读取一条响应，返回其请求id(没有则为0)
+std::uint32_t readFrame(boost::asio::ip::tcp::socket &sock, Json::Value &read) {
+  std::array<char, HEAD_LENGTH + HEAD_LENGTH> head;
+  boost::asio::read(sock, boost::asio::buffer(head.data(), head.size()));
+  u_short head_id = 0;
+  memcpy(&head_id, head.data(), HEAD_LENGTH);
+  head_id = boost::asio::detail::socket_ops::network_to_host_short(head_id);
+  u_short len = 0;
+  memcpy(&len, head.data() + HEAD_LENGTH, HEAD_LENGTH);
+  len = boost::asio::detail::socket_ops::network_to_host_short(len);
+
+  std::uint32_t req_id = 0;
+  if ((head_id & REQ_ID_FLAG) != 0) {
+    boost::asio::read(sock, boost::asio::buffer(&req_id, REQ_ID_LENGTH));
+    req_id = static_cast<std::uint32_t>(boost::asio::detail::socket_ops::network_to_host_long(req_id));
+  }
+
+  std::array<char, MAX_LENGTH + 1> recv{};
+  boost::asio::read(sock, boost::asio::buffer(recv.data(), len));
+
+  Json::CharReaderBuilder read_builder;
+  std::stringstream sss{recv.data()};
+  std::string errors;
+  Json::parseFromStream(read_builder, sss, &read, &errors);
+  return req_id;
+}
+
+void clientThread(int threadId, int messages, int pipeline, const std::string &host, const std::string &port) {
   try {
+    // 所有线程同时启动，同一主机只会真正解析一次
+    auto endpoints = dnsCache.AsyncResolve(host, port, boost::asio::use_future).get();
+
     boost::asio::io_context ioc;
-    boost::asio::ip::tcp::endpoint enp{boost::asio::ip::make_address_v4("127.0.0.1"), 10088};
     boost::asio::ip::tcp::socket sock{ioc};
-    sock.connect(enp);
-
-    for (int i = 0; i < 500; ++i) {
-      // 发送数据
-      Json::Value root;
-      root["test"] = "test str";
-      root["data"] = "hello from thread " + std::to_string(threadId) + " message " + std::to_string(i);
-      Json::StreamWriterBuilder builder;
-      std::string raw_str = Json::writeString(builder, root);
-
-      short data_id = 1001;
-      data_id = (short)boost::asio::detail::socket_ops::host_to_network_short(static_cast<u_short>(data_id));
-      auto send_len = static_cast<short>(raw_str.length());
-      send_len = (short)boost::asio::detail::socket_ops::host_to_network_short(static_cast<u_short>(send_len));
-      std::array<char, MAX_LENGTH> send_date;
-      memcpy(send_date.data(), &data_id, HEAD_LENGTH);
-      memcpy(send_date.data() + HEAD_LENGTH, &send_len, HEAD_LENGTH);
-      memcpy(send_date.data() + HEAD_LENGTH + HEAD_LENGTH, raw_str.c_str(), raw_str.size());
-      boost::asio::write(sock, boost::asio::buffer(send_date.data(), raw_str.length() + HEAD_LENGTH + HEAD_LENGTH));
-
-      // 接收数据
-      std::array<char, HEAD_LENGTH> head_id;
-      boost::asio::read(sock, boost::asio::buffer(head_id.data(), HEAD_LENGTH));
-      short head_id_local = 0;
-      memcpy(&head_id_local, head_id.data(), HEAD_LENGTH);
-      head_id_local = (short)boost::asio::detail::socket_ops::network_to_host_short(static_cast<u_short>(head_id_local));
-
-      // 读取头部长度
-      std::array<char, HEAD_LENGTH> head_len;
-      boost::asio::read(sock, boost::asio::buffer(head_len.data(), HEAD_LENGTH));
-      short len = 0;
-      memcpy(&len, head_len.data(), HEAD_LENGTH);
-      len = (short)boost::asio::detail::socket_ops::network_to_host_short(static_cast<u_short>(len));
-
-      std::array<char, MAX_LENGTH> recv;
-      boost::asio::read(sock, boost::asio::buffer(recv.data(), static_cast<size_t>(len)));
-
-      Json::CharReaderBuilder read_builder;
-      std::stringstream sss{recv.data()};
+    boost::asio::connect(sock, endpoints);
+
+    std::vector<double> local_latencies;
+    local_latencies.reserve(static_cast<std::size_t>(messages));
+    std::unordered_map<std::uint32_t, Clock::time_point> in_flight;
+
+    int sent = 0;
+    std::uint32_t next_req_id = 1;
+    auto send_one = [&]() -> void {
+      std::uint32_t req_id = pipeline > 1 ? next_req_id++ : 0;
+      in_flight[req_id] = Clock::now();
+      boost::asio::write(sock, boost::asio::buffer(buildFrame(threadId, sent, req_id)));
+      ++sent;
+    };
+
+    // 先填满窗口，之后每收到一条响应再补发一条
+    while (sent < std::min(pipeline, messages)) {
+      send_one();
+    }
+
+    for (int received = 0; received < messages; ++received) {
       Json::Value read;
-      std::string errors;
-      Json::parseFromStream(read_builder, sss, &read, &errors);
+      std::uint32_t req_id = readFrame(sock, read);
+
+      if (auto iter = in_flight.find(req_id); iter != in_flight.end()) {
+        local_latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - iter->second).count());
+        in_flight.erase(iter);
+      } else {
+        std::cout << "Thread " << threadId << " unknown request id: " << req_id << '\n';
+      }
 
-      if (i % 100 == 0) {  // 每100次打印一次进度
-        std::cout << "Thread " << threadId << " - Message " << i << " received: " << read["test"].asString() << " | " << read["data"].asString() << '\n';
+      if (sent < messages) {
+        send_one();
       }
     }
 
-    std::cout << "Thread " << threadId << " completed 500 messages\n";
+    std::cout << "Thread " << threadId << " completed " << messages << " messages\n";
 
+    std::lock_guard<std::mutex> lock{latency_mtx};
+    latencies_us.insert(latencies_us.end(), local_latencies.begin(), local_latencies.end());
   } catch (const std::exception &ex) {
     std::cout << "Thread " << threadId << " error: " << ex.what() << '\n';
   } catch (const boost::system::error_code &err) {
@@ -79,31 +141,44 @@ void clientThread(int threadId) {
   }
 }
 
-int main() {
+// 用法: client [线程数] [每线程消息数] [流水线深度] [主机] [端口]
+int main(int argc, char *argv[]) {
+  int thread_count = argc > 1 ? std::atoi(argv[1]) : 100;
+  int messages = argc > 2 ? std::atoi(argv[2]) : 500;
+  int pipeline = argc > 3 ? std::max(1, std::atoi(argv[3])) : 1;
+  std::string host = argc > 4 ? argv[4] : "127.0.0.1";
+  std::string port = argc > 5 ? argv[5] : "10088";
+
   std::vector<std::thread> threads;
-  threads.reserve(100);
+  threads.reserve(static_cast<std::size_t>(thread_count));
 
-  auto start_time = std::chrono::high_resolution_clock::now();
-  std::cout << "Starting 100 client threads...\n";
+  auto start_time = Clock::now();
+  std::cout << "Starting " << thread_count << " client threads, pipeline depth " << pipeline << "...\n";
 
-  for (int i = 0; i < 100; ++i) {
-    threads.emplace_back(clientThread, i);
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-    std::cout << "Created thread " << i << '\n';
+  for (int i = 0; i < thread_count; ++i) {
+    threads.emplace_back(clientThread, i, messages, pipeline, std::cref(host), std::cref(port));
   }
 
-  std::cout << "All threads created, waiting for completion...\n";
-
   // 等待所有线程完成
   for (auto &thread : threads) {
     thread.join();
   }
 
-  auto end_time = std::chrono::high_resolution_clock::now();
+  auto end_time = Clock::now();
   auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
 
   std::cout << "All threads completed!\n";
   std::cout << "Total execution time: " << duration.count() << " ms (" << static_cast<double>(duration.count()) / 1000.0 << " seconds)\n";
 
+  if (!latencies_us.empty()) {
+    std::sort(latencies_us.begin(), latencies_us.end());
+    auto percentile = [](double pct) -> double {
+      return latencies_us[static_cast<std::size_t>(pct * static_cast<double>(latencies_us.size() - 1))];
+    };
+    double seconds = std::max(1.0, static_cast<double>(duration.count())) / 1000.0;
+    std::cout << "Throughput: " << static_cast<double>(latencies_us.size()) / seconds << " msg/s\n";
+    std::cout << "Latency p50: " << percentile(0.50) << " us, p99: " << percentile(0.99) << " us, max: " << latencies_us.back() << " us\n";
+  }
+
   return 0;
-}
\ No newline at end of file
+}
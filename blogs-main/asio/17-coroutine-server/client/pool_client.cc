@@ -0,0 +1,87 @@
+#include <core/dns/DnsCache.hpp>
+#include <core/msg-node/MsgNode.hpp>
+#include <core/upstream/ConnectionPool.hpp>
+#include <global/Global.hpp>
+
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// 对比每次请求新建连接与经由出站连接池复用连接的延迟
+// 用法: pool_client [请求数] [并发数] [主机] [端口]
+
+using Clock = std::chrono::steady_clock;
+
+std::string host;
+std::string port;
+const std::string body = R"({"data":"hello from pool client","test":"test str"})";
+
+// 每次请求: 解析 -> 连接 -> 写一帧 -> 读回一帧 -> 关闭
+boost::asio::awaitable<void> freshRequest() {
+  auto executor = co_await boost::asio::this_coro::executor;
+  auto endpoints = co_await dnsCache.AsyncResolve(host, port, boost::asio::use_awaitable);
+  boost::asio::ip::tcp::socket sock{executor};
+  co_await boost::asio::async_connect(sock, endpoints, boost::asio::use_awaitable);
+
+  core::SendNode node{static_cast<short>(MSG_TYPE::MSG_HELLO_WORLD), static_cast<short>(body.size()), body.data()};
+  co_await boost::asio::async_write(sock, boost::asio::buffer(node._data, static_cast<std::size_t>(node._msg_len)), boost::asio::use_awaitable);
+
+  char head[MSG_HEAD_TOTAL_LEN];
+  co_await boost::asio::async_read(sock, boost::asio::buffer(head), boost::asio::use_awaitable);
+  u_short len = 0;
+  memcpy(&len, head + MSG_TYPE_LENGTH, MSG_LEN_LENGTH);
+  std::string recv(boost::asio::detail::socket_ops::network_to_host_short(len), '\0');
+  co_await boost::asio::async_read(sock, boost::asio::buffer(recv), boost::asio::use_awaitable);
+}
+
+boost::asio::awaitable<void> pooledRequest() {
+  co_await connectionPool.AsyncCall(host, port, static_cast<short>(MSG_TYPE::MSG_HELLO_WORLD), body, boost::asio::use_awaitable);
+}
+
+void run(const char *name, boost::asio::awaitable<void> (*request)(), int requests, int concurrency) {
+  boost::asio::io_context ioc;
+  std::vector<double> latencies;
+  latencies.reserve(static_cast<std::size_t>(requests));
+  int failed = 0;
+
+  auto start = Clock::now();
+  for (int i = 0; i < concurrency; ++i) {
+    boost::asio::co_spawn(ioc, [&, count = requests / concurrency]() -> boost::asio::awaitable<void> {
+      for (int j = 0; j < count; ++j) {
+        auto begin = Clock::now();
+        try {
+          co_await request();
+          latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - begin).count());
+        } catch (const boost::system::system_error &err) {
+          ++failed;
+        }
+      }
+    }, boost::asio::detached);
+  }
+  ioc.run();
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double pct) -> double {
+    return latencies.empty() ? 0.0 : latencies[static_cast<std::size_t>(pct * static_cast<double>(latencies.size() - 1))];
+  };
+  std::cout << name << ": " << static_cast<double>(latencies.size()) / seconds << " req/s, p50: " << percentile(0.50)
+            << " us, p99: " << percentile(0.99) << " us, failed: " << failed << '\n';
+}
+
+int main(int argc, char *argv[]) {
+  int requests = argc > 1 ? std::atoi(argv[1]) : 10000;
+  int concurrency = argc > 2 ? std::max(1, std::atoi(argv[2])) : 16;
+  host = argc > 3 ? argv[3] : "127.0.0.1";
+  port = argc > 4 ? argv[4] : "10088";
+
+  run("fresh connection", freshRequest, requests, concurrency);
+  run("connection pool", pooledRequest, requests, concurrency);
+  std::cout << connectionPool.Report();
+}
@@ -16,14 +16,58 @@
 #define MSG_TYPE_LENGTH 2
 #define MSG_LEN_LENGTH 2
 #define MSG_HEAD_TOTAL_LEN 4
+// 消息类型最高位置1时，头部后紧跟4字节的请求id，用于请求与响应的对应
+#define MSG_REQ_ID_FLAG 0x8000
+#define MSG_REQ_ID_LENGTH 4
+// 消息类型次高位置1时，消息体为LZ4压缩后的数据
+#define MSG_COMPRESSED_FLAG 0x4000
+#define MSG_TYPE_MASK 0x3FFF
+// 小于该长度的消息体压缩收益不大，直接发送
+#define COMPRESS_MIN_BODY_LEN 256
 #define MSG_BODY_LENGTH 1024 * 2
 #define RECV_QUEUE_MAX_LEN 10000
+// 发送队列的硬上限，正常由下面的水位暂停读取来限制，超过时说明对端读不过来，直接断开
 #define SEND_QUEUE_MAX_LEN 1000
 
+// 流量控制: 单个会话的高低水位(逻辑在途消息数、发送积压的字节数与消息数)以及全局内存预算
+#define SESSION_LOGIC_HIGH_WATER 64
+#define SESSION_LOGIC_LOW_WATER 16
+#define SESSION_SEND_HIGH_WATER 1024 * 256
+#define SESSION_SEND_LOW_WATER 1024 * 64
+#define SESSION_SEND_COUNT_HIGH_WATER 256
+#define SESSION_SEND_COUNT_LOW_WATER 64
+#define GLOBAL_MEMORY_BUDGET 1024 * 1024 * 256
+#define FLOW_CONTROL_RECHECK_MS 50
+
+// 域名解析缓存: 成功与失败结果的缓存秒数(失败结果到期即移除)，过期前多久开始后台刷新，以及刷新失败后首次重试的间隔(之后翻倍，不超过旧结果的剩余有效期)
+#define DNS_CACHE_TTL_SEC 60
+#define DNS_NEGATIVE_TTL_SEC 5
+#define DNS_REFRESH_AHEAD_SEC 10
+#define DNS_REFRESH_RETRY_SEC 1
+
+// 出站连接池: 每个后端的最大连接数、连接超时、单次调用的截止时间、空闲心跳间隔，以及熔断的失败阈值与打开时长
+#define UPSTREAM_POOL_SIZE 4
+#define UPSTREAM_CONNECT_TIMEOUT_MS 3000
+#define UPSTREAM_CALL_TIMEOUT_MS 5000
+#define UPSTREAM_PING_INTERVAL_MS 15000
+#define UPSTREAM_BREAKER_FAILURES 5
+#define UPSTREAM_BREAKER_OPEN_MS 5000
+
+// gRPC网关: 监听地址、完成队列数、每个完成队列的调用槽数(即该队列同时处理的调用上限)，以及关闭时等待在途调用的时间
+#define GATEWAY_GRPC_ADDRESS "0.0.0.0:50051"
+#define GATEWAY_CQ_COUNT 1
+#define GATEWAY_CALL_SLOTS 256
+#define GATEWAY_SHUTDOWN_TIMEOUT_MS 1000
+
 #define MSG_TYPE_MAX_NUM 65535
 
 enum class MSG_TYPE : std::uint16_t {
   MSG_HELLO_WORLD = 1001,
+  MSG_TOPIC_SUBSCRIBE = 1002,
+  MSG_TOPIC_UNSUBSCRIBE = 1003,
+  MSG_TOPIC_PUBLISH = 1004,
+  MSG_COMPRESS_NEGOTIATE = 1005,
+  MSG_HEARTBEAT = 1006,
 };
 
 #endif // GLOBAL_HPP
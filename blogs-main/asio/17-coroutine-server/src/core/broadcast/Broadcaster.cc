@@ -0,0 +1,147 @@
+#include "Broadcaster.hpp"
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <unordered_map>
+
+#include <middleware/Logger.hpp>
+#include <core/io-pool/IoPool.hpp>
+#include <core/session/Session.hpp>
+#include <core/msg-node/MsgNode.hpp>
+#include <core/flow-control/MemoryBudget.hpp>
+
+#include <boost/asio/post.hpp>
+
+namespace core {
+
+using SessionMap = std::unordered_map<std::string, std::shared_ptr<Session>>;
+
+// 每个io_context一个分片，分片内的会话都跑在该io_context上
+struct Shard {
+  boost::asio::io_context *_ioc;
+
+  std::mutex _mutex;
+  SessionMap _sessions;
+  std::unordered_map<std::string, SessionMap> _topics;
+};
+
+struct Broadcaster::_impl {
+  std::vector<std::unique_ptr<Shard>> _shards;
+
+  _impl() {
+    const std::size_t size = ioPool.size();
+    _shards.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      auto shard = std::make_unique<Shard>();
+      shard->_ioc = &ioPool.getIoContext(i);
+      _shards.emplace_back(std::move(shard));
+    }
+  }
+
+  // 分片数等于io线程数，线性查找即可
+  Shard *findShard(const boost::asio::io_context &ioc) {
+    for (auto &shard : _shards) {
+      if (shard->_ioc == &ioc) {
+        return shard.get();
+      }
+    }
+    logger.error("No broadcast shard for the io_context");
+    return nullptr;
+  }
+
+  // 在分片所属的io线程上完成投递，大量订阅者的扇出被分摊到所有io线程；
+  // 锁内只复制目标会话，Send在锁外进行，扇出期间不阻塞本分片的加入、移除与订阅
+  static void deliver(Shard *shard, const std::shared_ptr<const SendNode> &node, const std::string *topic) {
+    std::vector<std::shared_ptr<Session>> targets;
+    {
+      std::lock_guard<std::mutex> lock{shard->_mutex};
+      const SessionMap *sessions = &shard->_sessions;
+      if (topic != nullptr) {
+        auto iter = shard->_topics.find(*topic);
+        if (iter == shard->_topics.end()) {
+          return;
+        }
+        sessions = &iter->second;
+      }
+
+      targets.reserve(sessions->size());
+      for (const auto &[uuid, session] : *sessions) {
+        targets.emplace_back(session);
+      }
+    }
+
+    for (const auto &session : targets) {
+      session->Send(node);
+    }
+  }
+
+  void fanOut(const std::shared_ptr<const SendNode> &node, const std::shared_ptr<const std::string> &topic) {
+    for (auto &shard : _shards) {
+      boost::asio::post(*shard->_ioc, [shard = shard.get(), node, topic]() -> void {
+        deliver(shard, node, topic.get());
+      });
+    }
+  }
+};
+
+Broadcaster::Broadcaster() : _pimpl(std::make_unique<_impl>()) {}
+
+Broadcaster::~Broadcaster() {
+  logger.debug("The broadcaster has been released!");
+}
+
+void Broadcaster::AddSession(const std::shared_ptr<Session> &session) {
+  if (auto *shard = _pimpl->findShard(session->getIoContext()); shard != nullptr) {
+    std::lock_guard<std::mutex> lock{shard->_mutex};
+    shard->_sessions[session->getUuid()] = session;
+  }
+}
+
+void Broadcaster::RemoveSession(boost::asio::io_context &ioc, const std::string &uuid) {
+  if (auto *shard = _pimpl->findShard(ioc); shard != nullptr) {
+    std::lock_guard<std::mutex> lock{shard->_mutex};
+    shard->_sessions.erase(uuid);
+    for (auto iter = shard->_topics.begin(); iter != shard->_topics.end();) {
+      iter->second.erase(uuid);
+      iter = iter->second.empty() ? shard->_topics.erase(iter) : std::next(iter);
+    }
+  }
+}
+
+// 订阅在逻辑线程上执行，可能晚于关闭时的RemoveSession；会话在读取前已注册，同一把锁下查不到说明已经注销，不能再加回主题表
+void Broadcaster::Subscribe(const std::shared_ptr<Session> &session, const std::string &topic) {
+  if (auto *shard = _pimpl->findShard(session->getIoContext()); shard != nullptr) {
+    std::lock_guard<std::mutex> lock{shard->_mutex};
+    auto iter = shard->_sessions.find(session->getUuid());
+    if (iter == shard->_sessions.end() || iter->second != session) {
+      return;
+    }
+    shard->_topics[topic][session->getUuid()] = session;
+  }
+}
+
+void Broadcaster::Unsubscribe(const std::shared_ptr<Session> &session, const std::string &topic) {
+  if (auto *shard = _pimpl->findShard(session->getIoContext()); shard != nullptr) {
+    std::lock_guard<std::mutex> lock{shard->_mutex};
+    if (auto iter = shard->_topics.find(topic); iter != shard->_topics.end()) {
+      iter->second.erase(session->getUuid());
+      if (iter->second.empty()) {
+        shard->_topics.erase(iter);
+      }
+    }
+  }
+}
+
+void Broadcaster::Publish(const std::string &topic, short msgType, short msgLen, const char *msgBody) {
+  auto node = memoryBudget.MakeSendNode(msgType, msgLen, msgBody);
+  _pimpl->fanOut(node, std::make_shared<const std::string>(topic));
+}
+
+void Broadcaster::Broadcast(short msgType, short msgLen, const char *msgBody) {
+  auto node = memoryBudget.MakeSendNode(msgType, msgLen, msgBody);
+  _pimpl->fanOut(node, nullptr);
+}
+
+} // namespace core
@@ -0,0 +1,62 @@
+/******************************************************************************
+ *
+ * @file       Broadcaster.hpp
+ * @brief      全服广播与主题订阅，按io_context分片扇出共享的发送节点
+ *
+ * @author     KBchulan
+ * @date       2026/10/19
+ * @history
+ ******************************************************************************/
+
+#ifndef BROADCASTER_HPP
+#define BROADCASTER_HPP
+
+#include <memory>
+#include <string>
+
+#include <core/CoreExport.hpp>
+#include <global/Singleton.hpp>
+
+#include <boost/asio/io_context.hpp>
+
+namespace core {
+
+class Session;
+class CORE_EXPORT Broadcaster final : public global::Singleton<Broadcaster> {
+  friend class global::Singleton<Broadcaster>;
+
+private:
+  Broadcaster();
+
+public:
+  ~Broadcaster();
+
+  // 会话的注册与注销，注销时会同时退订该会话的所有主题
+  void AddSession(const std::shared_ptr<Session> &session);
+  void RemoveSession(boost::asio::io_context &ioc, const std::string &uuid);
+
+  void Subscribe(const std::shared_ptr<Session> &session, const std::string &topic);
+  void Unsubscribe(const std::shared_ptr<Session> &session, const std::string &topic);
+
+  /**
+    * @brief 消息只序列化一次，所有接收者共享同一个发送节点，扇出投递到各个分片所在的io线程
+    * @param topic 主题名称
+    * @param msgType 消息类型
+    * @param msgLen 消息体长度
+    * @param msgBody 消息体
+    **/
+  void Publish(const std::string &topic, short msgType, short msgLen, const char *msgBody);
+
+  // 发送给当前所有在线的会话
+  void Broadcast(short msgType, short msgLen, const char *msgBody);
+
+private:
+  struct _impl;
+  std::unique_ptr<_impl> _pimpl;
+};
+
+} // namespace core
+
+#define broadcaster core::Broadcaster::getInstance()
+
+#endif // BROADCASTER_HPP
@@ -0,0 +1,107 @@
+#include "Compressor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <format>
+
+#include <lz4.h>
+
+#include <global/Global.hpp>
+#include <middleware/Logger.hpp>
+
+namespace core {
+
+struct Compressor::_impl {
+  // 压缩方向: 原始字节、压缩后字节、耗时
+  std::atomic<std::uint64_t> _compress_count{0};
+  std::atomic<std::uint64_t> _compress_skipped{0};
+  std::atomic<std::uint64_t> _raw_bytes{0};
+  std::atomic<std::uint64_t> _compressed_bytes{0};
+  std::atomic<std::uint64_t> _compress_ns{0};
+
+  // 解压方向
+  std::atomic<std::uint64_t> _decompress_count{0};
+  std::atomic<std::uint64_t> _decompress_ns{0};
+
+  static std::uint64_t elapsedNs(std::chrono::steady_clock::time_point start) {
+    return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+  }
+};
+
+Compressor::Compressor() : _pimpl(std::make_unique<_impl>()) {}
+
+Compressor::~Compressor() {
+  logger.debug("The compressor has been released!");
+}
+
+CompressAlgo Compressor::ParseAlgo(std::string_view name) {
+  return name == "lz4" ? CompressAlgo::LZ4 : CompressAlgo::NONE;
+}
+
+std::string_view Compressor::AlgoName(CompressAlgo algo) {
+  switch (algo) {
+    case CompressAlgo::LZ4:  return "lz4";
+    case CompressAlgo::NONE: return "none";
+    default:                 return "none";
+  }
+}
+
+bool Compressor::Compress(const char *src, std::size_t len, std::string &out) {
+  if (len < COMPRESS_MIN_BODY_LEN) {
+    _pimpl->_compress_skipped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  out.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(len))));
+  int size = LZ4_compress_default(src, out.data(), static_cast<int>(len), static_cast<int>(out.size()));
+  _pimpl->_compress_ns.fetch_add(_impl::elapsedNs(start), std::memory_order_relaxed);
+
+  if (size <= 0 || static_cast<std::size_t>(size) >= len) {
+    _pimpl->_compress_skipped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  out.resize(static_cast<std::size_t>(size));
+  _pimpl->_compress_count.fetch_add(1, std::memory_order_relaxed);
+  _pimpl->_raw_bytes.fetch_add(len, std::memory_order_relaxed);
+  _pimpl->_compressed_bytes.fetch_add(out.size(), std::memory_order_relaxed);
+  return true;
+}
+
+bool Compressor::Decompress(const char *src, std::size_t len, std::string &out) {
+  auto start = std::chrono::steady_clock::now();
+  out.resize(MSG_BODY_LENGTH);
+  int size = LZ4_decompress_safe(src, out.data(), static_cast<int>(len), static_cast<int>(out.size()));
+  _pimpl->_decompress_ns.fetch_add(_impl::elapsedNs(start), std::memory_order_relaxed);
+
+  if (size < 0) {
+    return false;
+  }
+
+  out.resize(static_cast<std::size_t>(size));
+  _pimpl->_decompress_count.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+std::string Compressor::Report() const {
+  auto count = _pimpl->_compress_count.load(std::memory_order_relaxed);
+  auto raw = _pimpl->_raw_bytes.load(std::memory_order_relaxed);
+  auto compressed = _pimpl->_compressed_bytes.load(std::memory_order_relaxed);
+  auto compress_ns = _pimpl->_compress_ns.load(std::memory_order_relaxed);
+  auto decompress_count = _pimpl->_decompress_count.load(std::memory_order_relaxed);
+  auto decompress_ns = _pimpl->_decompress_ns.load(std::memory_order_relaxed);
+
+  double ratio = compressed == 0 ? 1.0 : static_cast<double>(raw) / static_cast<double>(compressed);
+  double attempts = static_cast<double>(count + _pimpl->_compress_skipped.load(std::memory_order_relaxed));
+
+  return std::format("compressed {} msgs, {} -> {} bytes, ratio {:.2f}, avg compress {:.0f} ns/msg; "
+                     "decompressed {} msgs, avg {:.0f} ns/msg",
+                     count, raw, compressed, ratio,
+                     attempts == 0 ? 0.0 : static_cast<double>(compress_ns) / attempts,
+                     decompress_count,
+                     decompress_count == 0 ? 0.0 : static_cast<double>(decompress_ns) / static_cast<double>(decompress_count));
+}
+
+} // namespace core
@@ -0,0 +1,67 @@
+/******************************************************************************
+ *
+ * @file       Compressor.hpp
+ * @brief      消息体的LZ4压缩，按会话协商开启，并统计压缩率与耗时
+ *
+ * @author     KBchulan
+ * @date       2026/10/19
+ * @history
+ ******************************************************************************/
+
+#ifndef COMPRESSOR_HPP
+#define COMPRESSOR_HPP
+
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include <core/CoreExport.hpp>
+#include <global/Singleton.hpp>
+
+namespace core {
+
+enum class CompressAlgo : std::uint8_t {
+  NONE,
+  LZ4
+};
+
+class CORE_EXPORT Compressor final : public global::Singleton<Compressor> {
+  friend class global::Singleton<Compressor>;
+
+private:
+  Compressor();
+
+public:
+  ~Compressor();
+
+  // 协商时客户端传入的算法名，不认识的一律视为不压缩
+  [[nodiscard]] static CompressAlgo ParseAlgo(std::string_view name);
+  [[nodiscard]] static std::string_view AlgoName(CompressAlgo algo);
+
+  /**
+    * @brief 压缩消息体，应在逻辑线程上调用，避免占用io线程
+    * @param src 原始数据
+    * @param len 原始长度
+    * @param out 压缩结果
+    * @return 小于阈值或压缩后没有变小时返回false，调用方应直接发送原文
+    **/
+  bool Compress(const char *src, std::size_t len, std::string &out);
+
+  // 解压失败(数据损坏或超过最大消息长度)时返回false
+  bool Decompress(const char *src, std::size_t len, std::string &out);
+
+  // 压缩率与CPU耗时的汇总
+  [[nodiscard]] std::string Report() const;
+
+private:
+  struct _impl;
+  std::unique_ptr<_impl> _pimpl;
+};
+
+} // namespace core
+
+#define compressor core::Compressor::getInstance()
+
+#endif // COMPRESSOR_HPP
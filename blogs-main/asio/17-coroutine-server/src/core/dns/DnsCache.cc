@@ -0,0 +1,192 @@
+#include "DnsCache.hpp"
+
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include <global/Global.hpp>
+#include <middleware/Logger.hpp>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+namespace core {
+
+using Clock = std::chrono::steady_clock;
+
+// 系统解析接口拿不到记录本身的TTL，成功与失败分别使用配置的缓存时间
+struct Entry {
+  DnsCache::Results _results;
+  boost::system::error_code _error;
+  Clock::time_point _expires;
+
+  bool _resolving{false};
+  bool _used{false};                        // 上次解析后是否被查询过，没人用的条目不再刷新
+  int _refresh_failures{0};                 // 连续刷新失败的次数，用于退避
+  std::vector<DnsCache::Callback> _waiters; // 等待本次解析结果的请求
+
+  std::unique_ptr<boost::asio::steady_timer> _refresh_timer;
+
+  [[nodiscard]] bool fresh(Clock::time_point now) const {
+    return _expires > now;
+  }
+};
+
+struct DnsCache::_impl {
+  // 解析与刷新定时器都跑在独立的线程上，不占用io线程
+  boost::asio::io_context _ioc;
+  boost::asio::executor_work_guard<boost::asio::io_context::executor_type> _work_guard;
+  boost::asio::ip::tcp::resolver _resolver;
+  std::jthread _thread;
+
+  std::mutex _mutex;
+  std::unordered_map<std::string, std::shared_ptr<Entry>> _entries;
+
+  _impl() : _work_guard(boost::asio::make_work_guard(_ioc)), _resolver(_ioc) {
+    _thread = std::jthread([this]() -> void { _ioc.run(); });
+  }
+
+  ~_impl() {
+    _work_guard.reset();
+    _ioc.stop();
+    if (_thread.joinable()) {
+      _thread.join();
+    }
+
+    // 刷新定时器的回调持有条目本身，先释放定时器打破循环引用
+    std::lock_guard<std::mutex> lock{_mutex};
+    for (auto &[key, entry] : _entries) {
+      entry->_refresh_timer.reset();
+    }
+  }
+
+  static std::string makeKey(const std::string &host, const std::string &service) {
+    return host + ':' + service;
+  }
+
+  // 在解析线程上执行
+  void resolve(const std::string &key, const std::shared_ptr<Entry> &entry, const std::string &host, const std::string &service) {
+    _resolver.async_resolve(host, service, [this, key, entry, host, service](const boost::system::error_code &err, const Results &results) -> void {
+      std::vector<Callback> waiters;
+      Clock::duration next;
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        auto now = Clock::now();
+        // 刷新失败时沿用旧结果直到过期，期间按退避间隔重试
+        bool keep_stale = err && !entry->_results.empty() && entry->fresh(now);
+        if (keep_stale) {
+          auto backoff = std::chrono::seconds(DNS_REFRESH_RETRY_SEC) * (1 << std::min(entry->_refresh_failures, 6));
+          next = std::min<Clock::duration>(backoff, entry->_expires - now);
+          ++entry->_refresh_failures;
+        } else {
+          entry->_results = results;
+          entry->_error = err;
+          entry->_expires = now + std::chrono::seconds(err ? DNS_NEGATIVE_TTL_SEC : DNS_CACHE_TTL_SEC);
+          entry->_refresh_failures = 0;
+          // 失败结果只缓存到过期，届时移除，不在后台重试
+          next = err ? std::chrono::seconds(DNS_NEGATIVE_TTL_SEC) : std::chrono::seconds(DNS_CACHE_TTL_SEC - DNS_REFRESH_AHEAD_SEC);
+        }
+        entry->_resolving = false;
+        entry->_used = false;
+        waiters.swap(entry->_waiters);
+      }
+
+      if (err) {
+        logger.warning("Resolve {} failed: {}", key, err.message());
+      }
+      for (auto &waiter : waiters) {
+        waiter(err, results);
+      }
+
+      scheduleRefresh(key, entry, host, service, next);
+    });
+  }
+
+  // 到期时若条目已过期或无人使用则移除，否则后台重新解析；保证每个条目在解析结束后总有一个定时器负责它
+  void scheduleRefresh(const std::string &key, const std::shared_ptr<Entry> &entry, const std::string &host, const std::string &service, Clock::duration delay) {
+    if (!entry->_refresh_timer) {
+      entry->_refresh_timer = std::make_unique<boost::asio::steady_timer>(_ioc);
+    }
+    entry->_refresh_timer->expires_after(delay);
+    entry->_refresh_timer->async_wait([this, key, entry, host, service](const boost::system::error_code &err) -> void {
+      if (err) {
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock{_mutex};
+      auto iter = _entries.find(key);
+      if (iter == _entries.end() || iter->second != entry || entry->_resolving) {
+        return;
+      }
+      if (!entry->_used || !entry->fresh(Clock::now())) {
+        _entries.erase(iter);
+        return;
+      }
+      if (!entry->_resolving) {
+        entry->_resolving = true;
+        resolve(key, entry, host, service);
+      }
+    });
+  }
+};
+
+DnsCache::DnsCache() : _pimpl(std::make_unique<_impl>()) {}
+
+DnsCache::~DnsCache() {
+  logger.debug("The dns cache has been released!");
+}
+
+void DnsCache::lookup(std::string host, std::string service, Callback callback) {
+  std::string key = _impl::makeKey(host, service);
+  Results results;
+  boost::system::error_code err;
+
+  {
+    std::lock_guard<std::mutex> lock{_pimpl->_mutex};
+    auto &entry = _pimpl->_entries[key];
+    if (!entry) {
+      entry = std::make_shared<Entry>();
+    }
+
+    if (entry->fresh(Clock::now())) {
+      entry->_used = true;
+      results = entry->_results;
+      err = entry->_error;
+    } else {
+      // 已有解析在进行中时只排队等待，合并并发请求
+      entry->_waiters.emplace_back(std::move(callback));
+      if (!entry->_resolving) {
+        entry->_resolving = true;
+        boost::asio::post(_pimpl->_ioc, [this, key, entry, host = std::move(host), service = std::move(service)]() -> void {
+          _pimpl->resolve(key, entry, host, service);
+        });
+      }
+      return;
+    }
+  }
+
+  callback(err, results);
+}
+
+std::optional<DnsCache::Results> DnsCache::Peek(const std::string &host, const std::string &service) {
+  std::lock_guard<std::mutex> lock{_pimpl->_mutex};
+  auto iter = _pimpl->_entries.find(_impl::makeKey(host, service));
+  if (iter == _pimpl->_entries.end() || !iter->second->fresh(Clock::now()) || iter->second->_error) {
+    return std::nullopt;
+  }
+  iter->second->_used = true;
+  return iter->second->_results;
+}
+
+void DnsCache::Invalidate(const std::string &host, const std::string &service) {
+  std::lock_guard<std::mutex> lock{_pimpl->_mutex};
+  auto iter = _pimpl->_entries.find(_impl::makeKey(host, service));
+  if (iter != _pimpl->_entries.end() && !iter->second->_resolving) {
+    _pimpl->_entries.erase(iter);
+  }
+}
+
+} // namespace core
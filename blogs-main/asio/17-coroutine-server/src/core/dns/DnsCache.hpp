@@ -0,0 +1,84 @@
+/******************************************************************************
+ *
+ * @file       DnsCache.hpp
+ * @brief      异步域名解析缓存，合并同一主机的并发解析并在过期前后台刷新
+ *
+ * @author     KBchulan
+ * @date       2026/10/19
+ * @history
+ ******************************************************************************/
+
+#ifndef DNSCACHE_HPP
+#define DNSCACHE_HPP
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <optional>
+#include <functional>
+
+#include <core/CoreExport.hpp>
+#include <global/Singleton.hpp>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/system/detail/error_code.hpp>
+
+namespace core {
+
+class CORE_EXPORT DnsCache final : public global::Singleton<DnsCache> {
+  friend class global::Singleton<DnsCache>;
+
+public:
+  using Results = boost::asio::ip::tcp::resolver::results_type;
+  using Callback = std::function<void(const boost::system::error_code &, const Results &)>;
+
+private:
+  DnsCache();
+
+public:
+  ~DnsCache();
+
+  /**
+    * @brief 异步解析，命中缓存时不会发起解析，同一主机的并发请求只解析一次
+    * @param host 主机名
+    * @param service 端口或服务名
+    * @param token 完成令牌，支持回调、use_awaitable、use_future等，完成时投递回令牌关联的执行器
+    **/
+  template <typename CompletionToken>
+  auto AsyncResolve(std::string host, std::string service, CompletionToken &&token) {
+    return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code, Results)>(
+      [this](auto handler, std::string h, std::string s) -> void {
+        auto work = boost::asio::make_work_guard(handler);
+        // 完成处理器可能只能移动，放进shared_ptr后才能存入std::function
+        auto shared = std::make_shared<decltype(handler)>(std::move(handler));
+        lookup(std::move(h), std::move(s), [shared, work = std::move(work)](const boost::system::error_code &err, const Results &results) mutable -> void {
+          auto executor = work.get_executor();
+          boost::asio::post(executor, [shared, err, results]() mutable -> void { (*shared)(err, results); });
+          work.reset();
+        });
+      },
+      token, std::move(host), std::move(service));
+  }
+
+  // 仅查询缓存，未命中或已过期返回空
+  [[nodiscard]] std::optional<Results> Peek(const std::string &host, const std::string &service);
+
+  // 手动使某个主机的缓存失效，例如连接该地址持续失败时
+  void Invalidate(const std::string &host, const std::string &service);
+
+private:
+  void lookup(std::string host, std::string service, Callback callback);
+
+  struct _impl;
+  std::unique_ptr<_impl> _pimpl;
+};
+
+} // namespace core
+
+#define dnsCache core::DnsCache::getInstance()
+
+#endif // DNSCACHE_HPP
@@ -0,0 +1,47 @@
+#include "MemoryBudget.hpp"
+
+#include <global/Global.hpp>
+#include <middleware/Logger.hpp>
+#include <core/msg-node/MsgNode.hpp>
+
+namespace core {
+
+MemoryBudget::MemoryBudget()
+  : _budget(GLOBAL_MEMORY_BUDGET), _low_water(GLOBAL_MEMORY_BUDGET / 4 * 3) {}
+
+MemoryBudget::~MemoryBudget() {
+  logger.debug("The memory budget has been released!");
+}
+
+void MemoryBudget::Acquire(std::size_t bytes) {
+  _used.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void MemoryBudget::Release(std::size_t bytes) {
+  _used.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+bool MemoryBudget::OverBudget() const {
+  return _used.load(std::memory_order_relaxed) >= _budget;
+}
+
+bool MemoryBudget::BelowLowWater() const {
+  return _used.load(std::memory_order_relaxed) <= _low_water;
+}
+
+std::size_t MemoryBudget::Used() const {
+  return _used.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<const SendNode> MemoryBudget::MakeSendNode(short msgType, short msgLen, const char *msgBody,
+                                                          std::uint32_t reqId, bool compressed) {
+  auto *node = new SendNode(msgType, msgLen, msgBody, reqId, compressed);
+  const auto node_len = static_cast<std::size_t>(node->_msg_len);
+  Acquire(node_len);
+  return {node, [this, node_len](const SendNode *sent) -> void {
+    Release(node_len);
+    delete sent;
+  }};
+}
+
+} // namespace core
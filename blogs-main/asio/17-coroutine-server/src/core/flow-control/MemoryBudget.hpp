@@ -0,0 +1,62 @@
+/******************************************************************************
+ *
+ * @file       MemoryBudget.hpp
+ * @brief      所有会话共享的全局内存预算，统计排队中的收发字节数
+ *
+ * @author     KBchulan
+ * @date       2026/10/19
+ * @history
+ ******************************************************************************/
+
+#ifndef MEMORYBUDGET_HPP
+#define MEMORYBUDGET_HPP
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include <core/CoreExport.hpp>
+#include <global/Singleton.hpp>
+
+namespace core {
+
+class SendNode;
+
+class CORE_EXPORT MemoryBudget final : public global::Singleton<MemoryBudget> {
+  friend class global::Singleton<MemoryBudget>;
+
+private:
+  MemoryBudget();
+
+public:
+  ~MemoryBudget();
+
+  void Acquire(std::size_t bytes);
+  void Release(std::size_t bytes);
+
+  // 超过预算时会话停止读取，回落到低水位以下才允许恢复
+  [[nodiscard]] bool OverBudget() const;
+  [[nodiscard]] bool BelowLowWater() const;
+
+  [[nodiscard]] std::size_t Used() const;
+
+  /**
+    * @brief 创建一个计入预算的发送节点
+    * @details 创建时计入一次，最后一个引用释放时归还；广播节点无论被多少个会话的发送队列共享，
+    *          占用的内存只有一份，预算也只计一份，订阅者再多也不会把全局预算提前耗尽
+    **/
+  [[nodiscard]] std::shared_ptr<const SendNode> MakeSendNode(short msgType, short msgLen, const char *msgBody,
+                                                             std::uint32_t reqId = 0, bool compressed = false);
+
+private:
+  std::size_t _budget;
+  std::size_t _low_water;
+  std::atomic<std::size_t> _used{0};
+};
+
+} // namespace core
+
+#define memoryBudget core::MemoryBudget::getInstance()
+
+#endif // MEMORYBUDGET_HPP
@@ -0,0 +1,94 @@
+#include "RateLimiter.hpp"
+
+#include <algorithm>
+
+namespace core {
+
+namespace {
+
+// 默认不限流，需要时由main或配置显式设置
+struct PolicyTable {
+  RateLimitPolicy _session;
+  std::unordered_map<short, RateLimitPolicy> _msgs;
+};
+
+PolicyTable &policyTable() {
+  static PolicyTable table;
+  return table;
+}
+
+} // namespace
+
+TokenBucket::TokenBucket(const RateLimitPolicy &policy)
+  : _rate(policy._rate), _burst(policy._burst), _tokens(policy._burst), _action(policy._action) {}
+
+void TokenBucket::refill(Clock::time_point now) {
+  const std::chrono::duration<double> elapsed = now - _last;
+  _last = now;
+  _tokens = std::min(_burst, _tokens + elapsed.count() * _rate);
+}
+
+TokenBucket::Clock::duration TokenBucket::WaitTime(Clock::time_point now) {
+  refill(now);
+  if (_tokens >= 1.0) {
+    return Clock::duration::zero();
+  }
+  return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>((1.0 - _tokens) / _rate));
+}
+
+void TokenBucket::Consume() {
+  _tokens -= 1.0;
+}
+
+void RateLimiter::SetSessionPolicy(const RateLimitPolicy &policy) {
+  policyTable()._session = policy;
+}
+
+void RateLimiter::SetMsgPolicy(short msgType, const RateLimitPolicy &policy) {
+  policyTable()._msgs[msgType] = policy;
+}
+
+RateLimiter::RateLimiter() {
+  const auto &table = policyTable();
+  _session_limited = table._session._rate > 0;
+  _session_bucket = TokenBucket{table._session};
+
+  for (const auto &[msg_type, policy] : table._msgs) {
+    if (policy._rate > 0) {
+      _msg_buckets.emplace(msg_type, TokenBucket{policy});
+    }
+  }
+}
+
+RateLimiter::Verdict RateLimiter::Check(short msgType) {
+  const auto now = Clock::now();
+  Verdict verdict{true, RateLimitAction::DELAY, Clock::duration::zero()};
+
+  // 消息类型的限流优先于会话整体限流
+  TokenBucket *msg_bucket = nullptr;
+  if (auto iter = _msg_buckets.find(msgType); iter != _msg_buckets.end()) {
+    msg_bucket = &iter->second;
+    if (auto wait = msg_bucket->WaitTime(now); wait > Clock::duration::zero()) {
+      verdict = {false, msg_bucket->Action(), wait};
+    }
+  }
+
+  if (_session_limited) {
+    if (auto wait = _session_bucket.WaitTime(now); wait > Clock::duration::zero() && verdict._allowed) {
+      verdict = {false, _session_bucket.Action(), wait};
+    }
+  }
+
+  if (verdict._allowed) {
+    if (msg_bucket != nullptr) {
+      msg_bucket->Consume();
+    }
+    if (_session_limited) {
+      _session_bucket.Consume();
+    }
+  }
+
+  return verdict;
+}
+
+} // namespace core
@@ -0,0 +1,89 @@
+/******************************************************************************
+ *
+ * @file       RateLimiter.hpp
+ * @brief      会话级与消息类型级的令牌桶限流，按时间戳惰性补充令牌
+ *
+ * @author     KBchulan
+ * @date       2026/10/19
+ * @history
+ ******************************************************************************/
+
+#ifndef RATELIMITER_HPP
+#define RATELIMITER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+
+#include <core/CoreExport.hpp>
+
+namespace core {
+
+// 超限后的处理方式
+enum class RateLimitAction : std::uint8_t {
+  REJECT,   // 丢弃该消息，继续读取
+  DELAY,    // 暂停读取直到令牌足够
+  CLOSE     // 直接断开连接
+};
+
+struct CORE_EXPORT RateLimitPolicy {
+  double _rate{0};      // 每秒补充的令牌数，0表示不限流
+  double _burst{0};     // 桶容量
+  RateLimitAction _action{RateLimitAction::DELAY};
+};
+
+class CORE_EXPORT TokenBucket {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  TokenBucket() = default;
+  explicit TokenBucket(const RateLimitPolicy &policy);
+
+  // 令牌不足时返回还需等待的时长，足够时返回0且不扣除
+  [[nodiscard]] Clock::duration WaitTime(Clock::time_point now);
+  void Consume();
+
+  [[nodiscard]] RateLimitAction Action() const { return _action; }
+
+private:
+  void refill(Clock::time_point now);
+
+  double _rate{0};
+  double _burst{0};
+  double _tokens{0};
+  RateLimitAction _action{RateLimitAction::DELAY};
+  Clock::time_point _last{Clock::now()};
+};
+
+class CORE_EXPORT RateLimiter {
+public:
+  using Clock = TokenBucket::Clock;
+
+  struct Verdict {
+    bool _allowed;
+    RateLimitAction _action;
+    Clock::duration _wait;
+  };
+
+  // 全局策略，默认都不限流，需在服务器开始接收连接前配置
+  static void SetSessionPolicy(const RateLimitPolicy &policy);
+  static void SetMsgPolicy(short msgType, const RateLimitPolicy &policy);
+
+  RateLimiter();
+
+  /**
+    * @brief 同时检查会话桶和该消息类型的桶，两者都放行时才扣除令牌
+    * @param msgType 消息类型
+    * @return 是否放行，不放行时给出动作和建议等待时长
+    **/
+  Verdict Check(short msgType);
+
+private:
+  bool _session_limited;
+  TokenBucket _session_bucket;
+  std::unordered_map<short, TokenBucket> _msg_buckets;
+};
+
+} // namespace core
+
+#endif // RATELIMITER_HPP
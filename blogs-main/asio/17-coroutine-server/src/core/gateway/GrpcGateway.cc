@@ -0,0 +1,322 @@
+#include "GrpcGateway.hpp"
+#include "demo.pb.h"
+
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <unordered_map>
+#include <condition_variable>
+
+#include <json/json.h>
+#include <json/value.h>
+#include <json/writer.h>
+#include <json/reader.h>
+
+#include <global/Global.hpp>
+#include <middleware/Logger.hpp>
+#include <core/io-pool/IoPool.hpp>
+#include <core/session/Session.hpp>
+#include <core/msg-node/MsgNode.hpp>
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/security/server_credentials.h>
+
+namespace core {
+
+struct GrpcGateway::_impl final : public LocalPeer {
+  /**
+    * @brief 网关的调用槽，启动时给每个完成队列分好固定数量，之后循环使用，不再分配
+    * @details 槽的下标加一就是它投递到逻辑队列时携带的请求id，逻辑线程的回复直接按id定位到槽。
+    *          一次调用依次经过 接入 → 读请求 → 逻辑处理 → Finish，Finish的完成事件回到所属完成队列后，槽重新挂起等待下一个调用；
+    *          逻辑处理阶段只有逻辑线程访问槽，其余阶段只有所属完成队列的线程访问，槽全部占用时新调用在gRPC内部排队
+    **/
+  class Slot {
+  public:
+    Slot(_impl &gateway, grpc::ServerCompletionQueue *cq, std::uint32_t reqId)
+      : _gateway(gateway), _cq(cq), _req_id(reqId) {}
+
+    // 清掉上一个调用留下的状态，向通用服务挂起一次接入；ServerContext不能复用，每次重建
+    void Arm();
+    void Proceed(bool ok);
+
+    // 逻辑线程上调用
+    void Reply(std::string_view body);
+    void Done();
+
+  private:
+    enum class Stage { Accept, Read, Logic, Finish };
+
+    void finish(const grpc::Status &status) {
+      _stage = Stage::Finish;
+      _stream->Finish(status, this);
+    }
+
+    _impl &_gateway;
+    grpc::ServerCompletionQueue *_cq;
+    const std::uint32_t _req_id;
+
+    Stage _stage{Stage::Accept};
+    std::optional<grpc::GenericServerContext> _ctx;
+    std::optional<grpc::GenericServerAsyncReaderWriter> _stream;
+    grpc::ByteBuffer _request;
+    grpc::ByteBuffer _response;
+    const Route *_route{nullptr};
+    bool _replied{false};
+    grpc::Status _status;
+  };
+
+  std::string _address;
+  std::size_t _cq_count;
+
+  std::unordered_map<std::string, Route> _routes;
+
+  grpc::AsyncGenericService _service;
+  std::unique_ptr<grpc::Server> _server;
+  std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> _cqs;
+  std::vector<std::jthread> _pollers;
+
+  // Start之后不再增删，逻辑线程可以不加锁按请求id查找
+  std::vector<std::unique_ptr<Slot>> _slots;
+
+  // 所有调用共用一个本地会话，回复经由OnSend回到网关
+  std::shared_ptr<Session> _session;
+
+  // 服务器关闭后每个槽走完手上的调用就停用，全部停用才能关闭完成队列
+  std::mutex _park_mutex;
+  std::condition_variable _park_cv;
+  std::size_t _parked{0};
+
+  _impl(std::string address, std::size_t cq_count)
+    : _address(std::move(address)), _cq_count(std::max<std::size_t>(cq_count, 1)),
+      _session(std::make_shared<Session>(ioPool.getIoContext(), static_cast<LocalPeer *>(this))) {}
+
+  [[nodiscard]] const Route *findRoute(const std::string &method) const {
+    auto iter = _routes.find(method);
+    return iter == _routes.end() ? nullptr : &iter->second;
+  }
+
+  [[nodiscard]] Slot *findSlot(std::uint32_t reqId) const {
+    if (reqId == 0 || reqId > _slots.size()) {
+      return nullptr;
+    }
+    return _slots[reqId - 1].get();
+  }
+
+  // 在完成队列线程上把请求转成消息投递到逻辑队列，投递失败时返回需要回复的状态
+  [[nodiscard]] std::optional<grpc::Status> dispatch(std::uint32_t reqId, const Route &route, grpc::ByteBuffer &request) {
+    thread_local std::string body;
+    body.clear();
+    if (!route._to_body(request, body) || body.size() > MSG_BODY_LENGTH) {
+      return grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "malformed request"};
+    }
+
+    auto node = std::make_shared<RecvNode>(route._msg_type, static_cast<short>(body.size()), reqId);
+    std::memcpy(node->_data, body.data(), body.size());
+    if (_session->PostLocal(std::move(node))) {
+      return std::nullopt;
+    }
+    return grpc::Status{grpc::StatusCode::RESOURCE_EXHAUSTED, "logic queue is full"};
+  }
+
+  void OnSend(short, const char *msgBody, short msgLen, std::uint32_t reqId) override {
+    if (Slot *slot = findSlot(reqId)) {
+      slot->Reply(std::string_view{msgBody, static_cast<std::size_t>(msgLen)});
+    }
+  }
+
+  void OnLogicDone(std::uint32_t reqId) override {
+    if (Slot *slot = findSlot(reqId)) {
+      slot->Done();
+    }
+  }
+
+  void park() {
+    std::lock_guard<std::mutex> lock{_park_mutex};
+    ++_parked;
+    _park_cv.notify_all();
+  }
+};
+
+void GrpcGateway::_impl::Slot::Arm() {
+  _stage = Stage::Accept;
+  _stream.reset();
+  _ctx.emplace();
+  _stream.emplace(&*_ctx);
+  _request.Clear();
+  _response.Clear();
+  _route = nullptr;
+  _replied = false;
+  _status = grpc::Status::OK;
+  _gateway._service.RequestCall(&*_ctx, &*_stream, _cq, _cq, this);
+}
+
+void GrpcGateway::_impl::Slot::Proceed(bool ok) {
+  switch (_stage) {
+    case Stage::Accept:
+      // 网关关闭后挂起的接入以ok为false返回，Finish之后重新挂起的也会立即失败，槽就此停用
+      if (!ok) {
+        _gateway.park();
+        return;
+      }
+      _route = _gateway.findRoute(_ctx->method());
+      if (_route == nullptr) {
+        finish(grpc::Status{grpc::StatusCode::UNIMPLEMENTED, "no route for " + _ctx->method()});
+        return;
+      }
+      _stage = Stage::Read;
+      _stream->Read(&_request, this);
+      return;
+    case Stage::Read:
+      // 一元方法只读一条，客户端没写就半关闭了
+      if (!ok) {
+        finish(grpc::Status{grpc::StatusCode::INVALID_ARGUMENT, "missing request"});
+        return;
+      }
+      // 投递成功后由逻辑线程接手，直到它发出Finish
+      _stage = Stage::Logic;
+      if (auto status = _gateway.dispatch(_req_id, *_route, _request)) {
+        finish(*status);
+      }
+      return;
+    case Stage::Logic:
+      return;
+    case Stage::Finish:
+      // 客户端是否还在都不影响，槽接着服务下一个调用
+      Arm();
+      return;
+  }
+}
+
+void GrpcGateway::_impl::Slot::Reply(std::string_view body) {
+  // 一条请求只取第一条回复
+  if (_replied) {
+    return;
+  }
+  _replied = true;
+  if (!_route->_from_body(body, _response)) {
+    _status = grpc::Status{grpc::StatusCode::INTERNAL, "malformed reply"};
+  }
+}
+
+void GrpcGateway::_impl::Slot::Done() {
+  _stage = Stage::Finish;
+  if (_replied && _status.ok()) {
+    _stream->WriteAndFinish(_response, grpc::WriteOptions(), grpc::Status::OK, this);
+  } else if (_replied) {
+    _stream->Finish(_status, this);
+  } else {
+    _stream->Finish(grpc::Status{grpc::StatusCode::INTERNAL, "no reply from logic system"}, this);
+  }
+}
+
+GrpcGateway::GrpcGateway(std::string address, std::size_t cq_count)
+  : _pimpl(std::make_unique<_impl>(std::move(address), cq_count)) {}
+
+GrpcGateway::~GrpcGateway() {
+  Shutdown();
+  logger.debug("The grpc gateway has been released!");
+}
+
+void GrpcGateway::addRoute(std::string method, Route route) {
+  _pimpl->_routes.insert_or_assign(std::move(method), std::move(route));
+}
+
+bool GrpcGateway::Start() {
+  grpc::ServerBuilder builder;
+  builder.AddListeningPort(_pimpl->_address, grpc::InsecureServerCredentials());
+  builder.RegisterAsyncGenericService(&_pimpl->_service);
+
+  std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> cqs;
+  for (std::size_t i = 0; i < _pimpl->_cq_count; ++i) {
+    cqs.push_back(builder.AddCompletionQueue());
+  }
+
+  _pimpl->_server = builder.BuildAndStart();
+  if (!_pimpl->_server) {
+    logger.error("Grpc gateway failed to listen on {}", _pimpl->_address);
+    return false;
+  }
+
+  _pimpl->_cqs = std::move(cqs);
+  for (auto &cq : _pimpl->_cqs) {
+    for (int i = 0; i < GATEWAY_CALL_SLOTS; ++i) {
+      auto req_id = static_cast<std::uint32_t>(_pimpl->_slots.size() + 1);
+      _pimpl->_slots.push_back(std::make_unique<_impl::Slot>(*_pimpl, cq.get(), req_id));
+    }
+  }
+  for (auto &slot : _pimpl->_slots) {
+    slot->Arm();
+  }
+  for (auto &cq : _pimpl->_cqs) {
+    _pimpl->_pollers.emplace_back([cq = cq.get()]() -> void {
+      void *tag = nullptr;
+      bool ok = false;
+      while (cq->Next(&tag, &ok)) {
+        static_cast<_impl::Slot *>(tag)->Proceed(ok);
+      }
+    });
+  }
+
+  logger.info("Grpc gateway is listening on {}, routes: {}", _pimpl->_address, _pimpl->_routes.size());
+  return true;
+}
+
+void GrpcGateway::Shutdown() {
+  if (!_pimpl->_server) {
+    return;
+  }
+
+  // 超时后仍未完成的调用被取消；已经投递到逻辑队列的调用要等逻辑线程发出Finish，槽随后停用
+  _pimpl->_server->Shutdown(std::chrono::system_clock::now() + std::chrono::milliseconds(GATEWAY_SHUTDOWN_TIMEOUT_MS));
+  {
+    std::unique_lock<std::mutex> lock{_pimpl->_park_mutex};
+    _pimpl->_park_cv.wait(lock, [this]() -> bool {
+      return _pimpl->_parked == _pimpl->_slots.size();
+    });
+  }
+
+  for (auto &cq : _pimpl->_cqs) {
+    cq->Shutdown();
+  }
+  _pimpl->_pollers.clear();
+  _pimpl->_server.reset();
+  _pimpl->_cqs.clear();
+  _pimpl->_slots.clear();
+  _pimpl->_parked = 0;
+  logger.info("Grpc gateway on {} has been shut down", _pimpl->_address);
+}
+
+void RegisterHelloRoutes(GrpcGateway &gateway) {
+  // SayHello对应TCP的MSG_HELLO_WORLD，名字放在data字段，回复取回处理后的data字段；流式方法没有对应的消息，回复UNIMPLEMENTED
+  gateway.AddUnary<hello::HelloRequest, hello::HelloResponse>(
+    "/hello.HelloEndpoint/SayHello", static_cast<short>(MSG_TYPE::MSG_HELLO_WORLD),
+    [](const hello::HelloRequest &request, std::string &body) -> bool {
+      Json::Value send_data;
+      send_data["test"] = "grpc gateway";
+      send_data["data"] = request.req();
+      Json::StreamWriterBuilder write_builder;
+      body = Json::writeString(write_builder, send_data);
+      return true;
+    },
+    [](std::string_view body, hello::HelloResponse &response) -> bool {
+      Json::CharReaderBuilder read_builder;
+      std::unique_ptr<Json::CharReader> reader{read_builder.newCharReader()};
+      Json::Value recv_data;
+      std::string errors;
+      if (!reader->parse(body.data(), body.data() + body.size(), &recv_data, &errors)) {
+        logger.error("Failed to parse reply for grpc gateway: {}", errors);
+        return false;
+      }
+      response.set_rsp(recv_data["data"].asString());
+      return true;
+    });
+}
+
+} // namespace core
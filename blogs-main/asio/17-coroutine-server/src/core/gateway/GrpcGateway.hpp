@@ -0,0 +1,93 @@
+/******************************************************************************
+ *
+ * @file       GrpcGateway.hpp
+ * @brief      进程内的gRPC入口，把一元调用直接转成逻辑系统的消息
+ *
+ * @author     KBchulan
+ * @date       2026/10/19
+ * @history
+ ******************************************************************************/
+
+#ifndef GRPCGATEWAY_HPP
+#define GRPCGATEWAY_HPP
+
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <string_view>
+
+#include <core/CoreExport.hpp>
+
+#include <grpcpp/impl/proto_utils.h>
+#include <grpcpp/support/byte_buffer.h>
+
+namespace core {
+
+/**
+  * @brief gRPC网关，与TCP的Server在同一进程内，共用逻辑线程、逻辑队列和全局内存预算
+  * @details 基于通用服务接收任意方法，按方法全名查路由表，请求转成消息体后经一个本地会话投递到逻辑队列，
+  *          逻辑线程的回复按请求id找回对应的调用，不经过网络也不再走TCP的分帧；
+  *          逻辑队列积压或全局预算用尽时直接回复RESOURCE_EXHAUSTED，两个入口按同一份容量排队；
+  *          每个完成队列固定GATEWAY_CALL_SLOTS个调用槽，网关自身同时处理的调用数因此有上限
+  **/
+class CORE_EXPORT GrpcGateway {
+public:
+  GrpcGateway(std::string address, std::size_t cq_count);
+
+  ~GrpcGateway();
+
+  GrpcGateway(const GrpcGateway &) = delete;
+  GrpcGateway &operator=(const GrpcGateway &) = delete;
+
+  /**
+    * @brief 注册一个一元方法，需在Start之前调用
+    * @param method 方法全名，如 /hello.HelloEndpoint/SayHello
+    * @param msgType 对应的逻辑层消息类型
+    * @param toBody 在完成队列线程上把请求转成消息体，返回false时回复INVALID_ARGUMENT
+    * @param fromBody 在逻辑线程上把回复的消息体转成响应，返回false时回复INTERNAL
+    **/
+  template <typename Request, typename Response>
+  void AddUnary(std::string method, short msgType,
+                std::function<bool(const Request &, std::string &)> toBody,
+                std::function<bool(std::string_view, Response &)> fromBody) {
+    Route route;
+    route._msg_type = msgType;
+    route._to_body = [toBody = std::move(toBody)](grpc::ByteBuffer &buffer, std::string &body) -> bool {
+      Request request;
+      return grpc::SerializationTraits<Request>::Deserialize(&buffer, &request).ok() && toBody(request, body);
+    };
+    route._from_body = [fromBody = std::move(fromBody)](std::string_view body, grpc::ByteBuffer &buffer) -> bool {
+      Response response;
+      bool own_buffer = false;
+      return fromBody(body, response) && grpc::SerializationTraits<Response>::Serialize(response, &buffer, &own_buffer).ok();
+    };
+    addRoute(std::move(method), std::move(route));
+  }
+
+  // 监听端口失败返回false
+  bool Start();
+
+  // 停止接收新调用，等逻辑线程处理完在途调用后退出所有完成队列线程
+  void Shutdown();
+
+private:
+  struct Route {
+    short _msg_type{0};
+    std::function<bool(grpc::ByteBuffer &, std::string &)> _to_body;
+    std::function<bool(std::string_view, grpc::ByteBuffer &)> _from_body;
+  };
+
+  void addRoute(std::string method, Route route);
+
+  struct _impl;
+  std::unique_ptr<_impl> _pimpl;
+};
+
+// 把HelloEndpoint的方法映射到对应的消息类型
+CORE_EXPORT void RegisterHelloRoutes(GrpcGateway &gateway);
+
+} // namespace core
+
+#endif // GRPCGATEWAY_HPP
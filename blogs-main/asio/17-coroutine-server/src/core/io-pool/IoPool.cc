@@ -32,7 +32,13 @@ struct IoPool::_impl {
     }
   }
 
-  ~_impl() = default;
+  // 仍有长连接等未完成的异步操作时run()不会返回，先停止再等待线程退出，最后才析构io_context
+  ~_impl() {
+    for (auto &io_context : _ioContexts) {
+      io_context.stop();
+    }
+    _threads.clear();
+  }
 };
 
 IoPool::IoPool(unsigned int size) : _pimpl(std::make_unique<_impl>(size)) {}
@@ -47,4 +53,12 @@ boost::asio::io_context &IoPool::getIoContext() {
   return _pimpl->_ioContexts[index];
 }
 
+boost::asio::io_context &IoPool::getIoContext(std::size_t index) {
+  return _pimpl->_ioContexts[index % _pimpl->_ioContexts.size()];
+}
+
+std::size_t IoPool::size() const {
+  return _pimpl->_ioContexts.size();
+}
+
 } // namespace core
\ No newline at end of file
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <thread>
+#include <cstddef>
 
 #include <core/CoreExport.hpp>
 #include <global/Singleton.hpp>
@@ -31,6 +32,9 @@ public:
   ~IoPool();
 
   boost::asio::io_context &getIoContext();
+  boost::asio::io_context &getIoContext(std::size_t index);
+
+  [[nodiscard]] std::size_t size() const;
 
 private:
   struct _impl;
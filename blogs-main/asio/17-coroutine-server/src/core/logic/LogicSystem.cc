@@ -7,6 +7,7 @@
 #include <atomic>
 #include <thread>
 #include <sstream>
+#include <string_view>
 #include <iostream>
 #include <condition_variable>
 
@@ -20,6 +21,8 @@
 #include <core/session/Session.hpp>
 #include <core/logic/LogicNode.hpp>
 #include <core/msg-node/MsgNode.hpp>
+#include <core/compress/Compressor.hpp>
+#include <core/broadcast/Broadcaster.hpp>
 
 namespace core {
 
@@ -27,6 +30,7 @@ struct LogicSystem::_impl {
   std::mutex _queue_mutex;
   std::condition_variable _queue_cv;
   std::queue<std::shared_ptr<LogicNode>> _msg_queue;
+  std::atomic<std::size_t> _queue_size{0};
 
   std::jthread _worker_thread;
 
@@ -62,6 +66,7 @@ struct LogicSystem::_impl {
           if (!_msg_queue.empty()) {
             logic_node = std::move(_msg_queue.front());
             _msg_queue.pop();
+            _queue_size.store(_msg_queue.size(), std::memory_order_relaxed);
           }
         }
 
@@ -78,6 +83,7 @@ struct LogicSystem::_impl {
           }
           logic_node = std::move(_msg_queue.front());
           _msg_queue.pop();
+          _queue_size.store(_msg_queue.size(), std::memory_order_relaxed);
         }
         ProcessMessage(logic_node);
       }
@@ -89,7 +95,7 @@ struct LogicSystem::_impl {
 
 void LogicSystem::_impl::RegisterCallback() {
   _msg_handlers[static_cast<short>(MSG_TYPE::MSG_HELLO_WORLD)] =
-    [](const std::shared_ptr<Session> &session, short msg_id, const char* data) -> void {
+    [](const std::shared_ptr<Session> &session, short msg_id, const char* data, std::uint32_t req_id) -> void {
       // 读数据
       Json::CharReaderBuilder read_builder;
       std::stringstream strs{data};
@@ -106,18 +112,100 @@ void LogicSystem::_impl::RegisterCallback() {
       recv_data["data"] = "server has received msg, " + recv_data["data"].asString();
       Json::StreamWriterBuilder write_builder;
       std::string send_str = Json::writeString(write_builder, recv_data);
-      session->Send(msg_id, static_cast<short>(send_str.size()), send_str.c_str());
+      session->Send(msg_id, static_cast<short>(send_str.size()), send_str.c_str(), req_id);
+    };
+
+  // 主题相关的消息体格式: {"topic": "xxx", "data": "xxx"}
+  auto parse_topic = [](const char *data, Json::Value &recv_data) -> bool {
+    Json::CharReaderBuilder read_builder;
+    std::stringstream strs{data};
+    std::string errors;
+
+    if (!Json::parseFromStream(read_builder, strs, &recv_data, &errors) || !recv_data["topic"].isString()) {
+      logger.error("Failed to parse topic message: {}", errors);
+      return false;
+    }
+    return true;
+  };
+
+  _msg_handlers[static_cast<short>(MSG_TYPE::MSG_TOPIC_SUBSCRIBE)] =
+    [parse_topic](const std::shared_ptr<Session> &session, short, const char* data, std::uint32_t) -> void {
+      Json::Value recv_data;
+      if (parse_topic(data, recv_data)) {
+        broadcaster.Subscribe(session, recv_data["topic"].asString());
+      }
+    };
+
+  _msg_handlers[static_cast<short>(MSG_TYPE::MSG_TOPIC_UNSUBSCRIBE)] =
+    [parse_topic](const std::shared_ptr<Session> &session, short, const char* data, std::uint32_t) -> void {
+      Json::Value recv_data;
+      if (parse_topic(data, recv_data)) {
+        broadcaster.Unsubscribe(session, recv_data["topic"].asString());
+      }
+    };
+
+  // 压缩协商: {"algo": "lz4"}，回复服务器最终采用的算法
+  _msg_handlers[static_cast<short>(MSG_TYPE::MSG_COMPRESS_NEGOTIATE)] =
+    [](const std::shared_ptr<Session> &session, short msg_id, const char* data, std::uint32_t req_id) -> void {
+      Json::CharReaderBuilder read_builder;
+      std::stringstream strs{data};
+      Json::Value recv_data;
+      std::string errors;
+
+      auto algo = CompressAlgo::NONE;
+      if (Json::parseFromStream(read_builder, strs, &recv_data, &errors)) {
+        algo = Compressor::ParseAlgo(recv_data["algo"].asString());
+      }
+
+      Json::Value reply;
+      reply["algo"] = std::string{Compressor::AlgoName(algo)};
+      Json::StreamWriterBuilder write_builder;
+      std::string send_str = Json::writeString(write_builder, reply);
+      session->Send(msg_id, static_cast<short>(send_str.size()), send_str.c_str(), req_id);
+
+      // 回复本身不压缩，之后的消息才按协商结果压缩
+      session->SetCompression(algo);
+    };
+
+  // 出站连接池的空闲心跳，原样回复空消息体
+  _msg_handlers[static_cast<short>(MSG_TYPE::MSG_HEARTBEAT)] =
+    [](const std::shared_ptr<Session> &session, short msg_id, const char*, std::uint32_t req_id) -> void {
+      session->Send(msg_id, 0, "", req_id);
+    };
+
+  // 发布的消息原样转发给该主题的所有订阅者，只序列化一次
+  _msg_handlers[static_cast<short>(MSG_TYPE::MSG_TOPIC_PUBLISH)] =
+    [parse_topic](const std::shared_ptr<Session> &, short msg_id, const char* data, std::uint32_t) -> void {
+      Json::Value recv_data;
+      if (parse_topic(data, recv_data)) {
+        std::string_view body{data};
+        broadcaster.Publish(recv_data["topic"].asString(), msg_id, static_cast<short>(body.size()), body.data());
+      }
     };
 }
 
 void LogicSystem::_impl::ProcessMessage(const std::shared_ptr<LogicNode>& logic_node) {
   auto msg_id = logic_node->_recvNode->getMsgId();
 
-  if (auto iter = _msg_handlers.find(msg_id); iter != _msg_handlers.end()) {
-    iter->second(logic_node->_session, msg_id, logic_node->_recvNode->_data);
+  // 压缩过的消息体在逻辑线程上解压，解压失败的消息直接丢弃
+  const char *data = logic_node->_recvNode->_data;
+  thread_local std::string decompressed;
+  bool valid = true;
+  if (logic_node->_recvNode->isCompressed()) {
+    valid = compressor.Decompress(data, static_cast<std::size_t>(logic_node->_recvNode->_msg_len), decompressed);
+    data = decompressed.c_str();
+  }
+
+  if (!valid) {
+    logger.error("Failed to decompress msg id: {}", msg_id);
+  } else if (auto iter = _msg_handlers.find(msg_id); iter != _msg_handlers.end()) {
+    iter->second(logic_node->_session, msg_id, data, logic_node->_recvNode->getReqId());
   } else {
     logger.error("no handler for msg id: {}", msg_id);
   }
+
+  // 归还会话的在途计数，必要时唤醒暂停中的读协程
+  logic_node->_session->LogicDone(static_cast<std::size_t>(logic_node->_recvNode->_msg_len), logic_node->_recvNode->getReqId());
 }
 
 LogicSystem::LogicSystem() : _pimpl(std::make_unique<_impl>()) {}
@@ -130,10 +218,15 @@ LogicSystem::~LogicSystem() {
 void LogicSystem::PostMsgToLogicQueue(const std::shared_ptr<LogicNode> &logic_node) {
   std::lock_guard<std::mutex> lock{_pimpl->_queue_mutex};
   _pimpl->_msg_queue.push(logic_node);
+  _pimpl->_queue_size.store(_pimpl->_msg_queue.size(), std::memory_order_relaxed);
 
   if (_pimpl->_msg_queue.size() == 1) {
     _pimpl->_queue_cv.notify_one();
   }
 }
 
+std::size_t LogicSystem::QueueSize() const {
+  return _pimpl->_queue_size.load(std::memory_order_relaxed);
+}
+
 } // namespace core
\ No newline at end of file
@@ -12,6 +12,8 @@
 #define LOGICSYSTEM_HPP
 
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 
 #include <core/CoreExport.hpp>
@@ -29,8 +31,9 @@ class CORE_EXPORT LogicSystem final : public global::Singleton<LogicSystem> {
     * @param session 共享指针，指向当前会话
     * @param msg_id 消息ID
     * @param data 消息数据
+    * @param req_id 请求id，为0表示客户端未携带，响应时原样带回即可乱序完成
     **/
-  using FunCallBack = std::function<void(const std::shared_ptr<Session>&, short, const char*)>;
+  using FunCallBack = std::function<void(const std::shared_ptr<Session>&, short, const char*, std::uint32_t)>;
 
 private:
   LogicSystem();
@@ -40,6 +43,9 @@ public:
 
   void PostMsgToLogicQueue(const std::shared_ptr<LogicNode> &logic_node);
 
+  // 当前逻辑队列中待处理的消息数，会话据此判断是否需要暂停读取
+  [[nodiscard]] std::size_t QueueSize() const;
+
 private:
   struct _impl;
   std::unique_ptr<_impl> _pimpl;
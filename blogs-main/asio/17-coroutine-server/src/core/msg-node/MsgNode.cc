@@ -2,7 +2,6 @@
 
 #include <cstddef>
 #include <cstring>
-#include <winsock2.h>
 
 #include <global/Global.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
@@ -28,21 +27,43 @@ short MsgNode::getMsgId() const {
 }
 
 
-RecvNode::RecvNode(short msg_id, short msg_len)
-  : MsgNode(msg_len), _msg_id(msg_id) {}
+RecvNode::RecvNode(short msg_id, short msg_len, std::uint32_t req_id, bool compressed)
+  : MsgNode(msg_len), _msg_id(msg_id), _req_id(req_id), _compressed(compressed) {}
 
 short RecvNode::getMsgId() const {
   return this->_msg_id;
 }
 
+std::uint32_t RecvNode::getReqId() const {
+  return this->_req_id;
+}
+
+bool RecvNode::isCompressed() const {
+  return this->_compressed;
+}
 
-SendNode::SendNode(short msg_id, short msg_len, const char *data)
-  : MsgNode(msg_len + MSG_HEAD_TOTAL_LEN), _msg_id(msg_id) {
-  auto net_msg_id = (short)boost::asio::detail::socket_ops::host_to_network_short(static_cast<u_short>(msg_id));
+
+SendNode::SendNode(short msg_id, short msg_len, const char *data, std::uint32_t req_id, bool compressed)
+  : MsgNode(static_cast<short>(msg_len + MSG_HEAD_TOTAL_LEN + (req_id != 0 ? MSG_REQ_ID_LENGTH : 0))), _msg_id(msg_id) {
+  auto wire_msg_id = static_cast<u_short>(msg_id);
+  if (req_id != 0) {
+    wire_msg_id = static_cast<u_short>(wire_msg_id | MSG_REQ_ID_FLAG);
+  }
+  if (compressed) {
+    wire_msg_id = static_cast<u_short>(wire_msg_id | MSG_COMPRESSED_FLAG);
+  }
+  auto net_msg_id = (short)boost::asio::detail::socket_ops::host_to_network_short(wire_msg_id);
   memcpy(_data, &net_msg_id, MSG_TYPE_LENGTH);
   auto net_msg_len = (short)boost::asio::detail::socket_ops::host_to_network_short(static_cast<u_short>(msg_len));
   memcpy(_data + MSG_TYPE_LENGTH, &net_msg_len, MSG_LEN_LENGTH);
-  memcpy(_data + MSG_HEAD_TOTAL_LEN, data, static_cast<size_t>(msg_len));
+
+  std::size_t offset = MSG_HEAD_TOTAL_LEN;
+  if (req_id != 0) {
+    auto net_req_id = static_cast<std::uint32_t>(boost::asio::detail::socket_ops::host_to_network_long(req_id));
+    memcpy(_data + offset, &net_req_id, MSG_REQ_ID_LENGTH);
+    offset += MSG_REQ_ID_LENGTH;
+  }
+  memcpy(_data + offset, data, static_cast<size_t>(msg_len));
 }
 
 short SendNode::getMsgId() const {
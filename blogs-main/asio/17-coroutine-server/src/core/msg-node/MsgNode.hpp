@@ -11,6 +11,8 @@
 #ifndef MSGNODE_HPP
 #define MSGNODE_HPP
 
+#include <cstdint>
+
 #include <core/CoreExport.hpp>
 
 namespace core {
@@ -37,17 +39,23 @@ public:
 
 class CORE_EXPORT RecvNode final : public MsgNode {
 public:
-  RecvNode(short msg_id, short msg_len);
+  RecvNode(short msg_id, short msg_len, std::uint32_t req_id = 0, bool compressed = false);
 
   [[nodiscard]] short getMsgId() const override;
+  [[nodiscard]] std::uint32_t getReqId() const;
+  [[nodiscard]] bool isCompressed() const;
 
 private:
   short _msg_id;
+  std::uint32_t _req_id;
+  bool _compressed;
 };
 
 class CORE_EXPORT SendNode final : public MsgNode {
 public:
-  SendNode(short msg_id, short msg_len, const char *data);
+  // req_id为0时使用普通头部，否则带上请求id，便于客户端流水线发送后乱序匹配
+  // compressed表示data已经压缩过，头部会带上压缩标记
+  SendNode(short msg_id, short msg_len, const char *data, std::uint32_t req_id = 0, bool compressed = false);
 
   [[nodiscard]] short getMsgId() const override;
 
@@ -7,6 +7,7 @@
 #include <middleware/Logger.hpp>
 #include <core/io-pool/IoPool.hpp>
 #include <core/session/Session.hpp>
+#include <core/broadcast/Broadcaster.hpp>
 
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ip/address_v4.hpp>
@@ -36,9 +37,13 @@ struct Server::_impl {
     if (errc) {
       logger.error("Accept error: {}", errc.message());
     } else {
+      // 先登记再开始读取，会话一开始就出错时能从这里和广播分片中移除自己
+      broadcaster.AddSession(new_session);
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _sessions[new_session->getUuid()] = new_session;
+      }
       new_session->Read();
-      std::lock_guard<std::mutex> lock(_mutex);
-      _sessions[new_session->getUuid()] = new_session;
     }
 
     start_accept();
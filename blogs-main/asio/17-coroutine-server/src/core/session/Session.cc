@@ -3,6 +3,7 @@
 #include <mutex>
 #include <queue>
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <cstddef>
 
@@ -12,16 +13,23 @@
 #include <core/logic/LogicNode.hpp>
 #include <core/msg-node/MsgNode.hpp>
 #include <core/logic/LogicSystem.hpp>
+#include <core/compress/Compressor.hpp>
+#include <core/broadcast/Broadcaster.hpp>
+#include <core/flow-control/RateLimiter.hpp>
+#include <core/flow-control/MemoryBudget.hpp>
 
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/uuid/random_generator.hpp>
 
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
 #include <boost/asio/awaitable.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/redirect_error.hpp>
 #include <boost/system/system_error.hpp>
 #include <boost/system/detail/error_code.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
@@ -31,6 +39,7 @@ namespace core {
 struct Session::_impl {
   boost::asio::io_context &_ioc;
   Server *_server;
+  LocalPeer *_peer;
 
   boost::asio::ip::tcp::socket _socket;
   std::string _uuid;
@@ -41,16 +50,97 @@ struct Session::_impl {
   std::shared_ptr<RecvNode> _recv_body_node;
 
   std::mutex _send_mtx;
-  std::queue<std::shared_ptr<SendNode>> _send_queue;
+  std::queue<std::shared_ptr<const SendNode>> _send_queue;
 
-  _impl(boost::asio::io_context &ioc, Server *server)
-      : _ioc(ioc), _server(server), _socket(ioc) {
+  // 流量控制: 投递到逻辑线程尚未处理完的消息数，以及发送队列中的消息数和字节数
+  // 发送字节数是本会话还要写出的积压，共享的广播节点在每个订阅者这里都计一份；全局预算按节点实际占用只计一份，由节点自己归还
+  std::atomic<std::size_t> _logic_inflight{0};
+  std::atomic<std::size_t> _send_count{0};
+  std::atomic<std::size_t> _send_bytes{0};
+  std::atomic_bool _read_paused{false};
+  boost::asio::steady_timer _resume_timer;
+
+  // 限流: 只在读协程中访问，无需加锁
+  RateLimiter _rate_limiter;
+  boost::asio::steady_timer _limit_timer;
+
+  // 协商得到的压缩算法
+  std::atomic<CompressAlgo> _compress_algo{CompressAlgo::NONE};
+
+  _impl(boost::asio::io_context &ioc, Server *server, LocalPeer *peer)
+      : _ioc(ioc), _server(server), _peer(peer), _socket(ioc), _resume_timer(ioc), _limit_timer(ioc) {
     boost::uuids::uuid uuid = boost::uuids::random_generator_mt19937()();
     _uuid = boost::uuids::to_string(uuid);
 
     _recv_head_node = std::make_shared<MsgNode>(MSG_HEAD_TOTAL_LEN);
   }
 
+  [[nodiscard]] bool overHighWater() const {
+    return _logic_inflight.load(std::memory_order_relaxed) >= SESSION_LOGIC_HIGH_WATER ||
+           _send_count.load(std::memory_order_relaxed) >= SESSION_SEND_COUNT_HIGH_WATER ||
+           _send_bytes.load(std::memory_order_relaxed) >= SESSION_SEND_HIGH_WATER ||
+           logicSystem.QueueSize() >= RECV_QUEUE_MAX_LEN ||
+           memoryBudget.OverBudget();
+  }
+
+  [[nodiscard]] bool belowLowWater() const {
+    return _logic_inflight.load(std::memory_order_relaxed) <= SESSION_LOGIC_LOW_WATER &&
+           _send_count.load(std::memory_order_relaxed) <= SESSION_SEND_COUNT_LOW_WATER &&
+           _send_bytes.load(std::memory_order_relaxed) <= SESSION_SEND_LOW_WATER &&
+           logicSystem.QueueSize() < RECV_QUEUE_MAX_LEN &&
+           memoryBudget.BelowLowWater();
+  }
+
+  // 队列回落后唤醒读协程，定时器只在io线程上操作
+  void tryResume(const std::shared_ptr<Session> &self) {
+    if (_read_paused.load(std::memory_order_acquire) && belowLowWater()) {
+      boost::asio::post(_ioc, [self]() -> void {
+        self->_pimpl->_resume_timer.cancel();
+      });
+    }
+  }
+
+  // 超过高水位时停止发起读取，直到回落到低水位以下，定时重检兜底全局预算的恢复
+  boost::asio::awaitable<void> waitForCapacity() {
+    if (!overHighWater()) {
+      co_return;
+    }
+
+    logger.warning("Session {} paused reading", _uuid);
+    _read_paused.store(true, std::memory_order_release);
+    while (!_isClosed && !belowLowWater()) {
+      boost::system::error_code errc;
+      _resume_timer.expires_after(std::chrono::milliseconds(FLOW_CONTROL_RECHECK_MS));
+      co_await _resume_timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, errc));
+    }
+    _read_paused.store(false, std::memory_order_release);
+    logger.info("Session {} resumed reading", _uuid);
+  }
+
+  // 返回该消息是否应当投递，DELAY时在此等待令牌补充
+  boost::asio::awaitable<bool> admit(short msgType) {
+    while (true) {
+      auto verdict = _rate_limiter.Check(msgType);
+      if (verdict._allowed) {
+        co_return true;
+      }
+
+      switch (verdict._action) {
+        case RateLimitAction::REJECT:
+          logger.warning("Session {} rate limited, drop message type: {}", _uuid, msgType);
+          co_return false;
+        case RateLimitAction::CLOSE:
+          logger.error("Session {} rate limited, closing", _uuid);
+          close();
+          co_return false;
+        case RateLimitAction::DELAY:
+          _limit_timer.expires_after(verdict._wait);
+          co_await _limit_timer.async_wait(boost::asio::use_awaitable);
+          break;
+      }
+    }
+  }
+
   void close() {
     bool expected = false;
 
@@ -59,6 +149,8 @@ struct Session::_impl {
         _socket.close();
       }
 
+      broadcaster.RemoveSession(_ioc, _uuid);
+
       if (_server != nullptr) {
         _server->removeSession(_uuid);
       }
@@ -67,7 +159,10 @@ struct Session::_impl {
 };
 
 Session::Session(boost::asio::io_context &ioc, Server *server)
-  : _pimpl(std::make_unique<_impl>(ioc, server)) {}
+  : _pimpl(std::make_unique<_impl>(ioc, server, nullptr)) {}
+
+Session::Session(boost::asio::io_context &ioc, LocalPeer *peer)
+  : _pimpl(std::make_unique<_impl>(ioc, nullptr, peer)) {}
 
 Session::~Session() = default;
 
@@ -75,15 +170,19 @@ void Session::Read() {
   boost::asio::co_spawn(_pimpl->_ioc, [self = shared_from_this()]() -> boost::asio::awaitable<void> {
     try {
       while (!self->_pimpl->_isClosed) {
+        co_await self->_pimpl->waitForCapacity();
+
         self->_pimpl->_recv_head_node->Clear();
         co_await boost::asio::async_read(self->_pimpl->_socket,
           boost::asio::buffer(self->_pimpl->_recv_head_node->_data, MSG_HEAD_TOTAL_LEN),
           boost::asio::use_awaitable);
 
-        // 解析接收到的数据
-        short msgType = 0;
-        memcpy(&msgType, self->_pimpl->_recv_head_node->_data, MSG_TYPE_LENGTH);
-        msgType = (short)boost::asio::detail::socket_ops::network_to_host_short(static_cast<u_short>(msgType));
+        // 解析接收到的数据，类型最高位表示后面跟着请求id
+        u_short rawType = 0;
+        memcpy(&rawType, self->_pimpl->_recv_head_node->_data, MSG_TYPE_LENGTH);
+        rawType = boost::asio::detail::socket_ops::network_to_host_short(rawType);
+        auto msgType = static_cast<short>(rawType & MSG_TYPE_MASK);
+        bool compressed = (rawType & MSG_COMPRESSED_FLAG) != 0;
         short msgLen = 0;
         memcpy(&msgLen, self->_pimpl->_recv_head_node->_data + MSG_TYPE_LENGTH, MSG_LEN_LENGTH);
         msgLen = (short)boost::asio::detail::socket_ops::network_to_host_short(static_cast<u_short>(msgLen));
@@ -94,16 +193,31 @@ void Session::Read() {
           co_return;
         }
 
-        logger.info("Received message type: {}, length: {}", msgType, msgLen);
+        std::uint32_t reqId = 0;
+        if ((rawType & MSG_REQ_ID_FLAG) != 0) {
+          co_await boost::asio::async_read(self->_pimpl->_socket,
+            boost::asio::buffer(&reqId, MSG_REQ_ID_LENGTH),
+            boost::asio::use_awaitable);
+          reqId = static_cast<std::uint32_t>(boost::asio::detail::socket_ops::network_to_host_long(reqId));
+        }
+
+        logger.info("Received message type: {}, length: {}, request id: {}", msgType, msgLen, reqId);
 
         // 读取消息内容
-        self->_pimpl->_recv_body_node = std::make_shared<RecvNode>(msgType, msgLen);
+        self->_pimpl->_recv_body_node = std::make_shared<RecvNode>(msgType, msgLen, reqId, compressed);
         self->_pimpl->_recv_body_node->Clear();
         co_await boost::asio::async_read(self->_pimpl->_socket,
             boost::asio::buffer(self->_pimpl->_recv_body_node->_data, static_cast<size_t>(msgLen)),
             boost::asio::use_awaitable);
 
-        // 投递到逻辑线程处理
+        // 限流检查，被拒绝的消息直接丢弃
+        if (!co_await self->_pimpl->admit(msgType)) {
+          continue;
+        }
+
+        // 投递到逻辑线程处理，消息体计入在途数量和全局预算，处理完后由LogicDone归还
+        self->_pimpl->_logic_inflight.fetch_add(1, std::memory_order_relaxed);
+        memoryBudget.Acquire(static_cast<std::size_t>(msgLen));
         logicSystem.PostMsgToLogicQueue(std::make_shared<LogicNode>(self, self->_pimpl->_recv_body_node));
       }
     } catch (const boost::system::system_error &err) {
@@ -113,36 +227,82 @@ void Session::Read() {
   }, boost::asio::detached);
 }
 
-void Session::Send(short msgType, short msgLen, const char *msgBody) {
-  auto send_node = std::make_shared<SendNode>(msgType, msgLen, msgBody);
+void Session::Send(short msgType, short msgLen, const char *msgBody, std::uint32_t reqId) {
+  // 本地会话不经过网络，原样交给对端
+  if (_pimpl->_peer != nullptr) {
+    _pimpl->_peer->OnSend(msgType, msgBody, msgLen, reqId);
+    return;
+  }
+
+  // 压缩在调用方线程(逻辑线程)完成，io线程只负责写
+  if (_pimpl->_compress_algo.load(std::memory_order_relaxed) == CompressAlgo::LZ4) {
+    thread_local std::string compressed;
+    if (compressor.Compress(msgBody, static_cast<std::size_t>(msgLen), compressed)) {
+      Send(memoryBudget.MakeSendNode(msgType, static_cast<short>(compressed.size()), compressed.data(), reqId, true));
+      return;
+    }
+  }
+
+  Send(memoryBudget.MakeSendNode(msgType, msgLen, msgBody, reqId));
+}
+
+void Session::Send(std::shared_ptr<const SendNode> node) {
+  // 共享节点已经带上了网络头部，本地会话不订阅主题，不应收到
+  if (_pimpl->_peer != nullptr) {
+    logger.warning("Local session {} does not accept framed send nodes", _pimpl->_uuid);
+    return;
+  }
+
   bool should_start_coroutine = false;
+  bool overflow = false;
+  const auto node_len = static_cast<std::size_t>(node->_msg_len);
 
   {
     std::lock_guard<std::mutex> lock(_pimpl->_send_mtx);
     should_start_coroutine = _pimpl->_send_queue.empty();
-    if (_pimpl->_send_queue.size() >= SEND_QUEUE_MAX_LEN) {
-      logger.error("Send queue is full, dropping message");
-      return;
+    overflow = _pimpl->_send_queue.size() >= SEND_QUEUE_MAX_LEN;
+    if (!overflow) {
+      _pimpl->_send_queue.emplace(std::move(node));
+      _pimpl->_send_count.fetch_add(1, std::memory_order_relaxed);
+      _pimpl->_send_bytes.fetch_add(node_len, std::memory_order_relaxed);
+    }
+  }
+
+  // 正常情况下积压到水位就会暂停读取，到不了这里；只有暂停读取也拦不住的来源(如广播)才会堆到硬上限，
+  // 此时对端显然读不过来，断开连接而不是悄悄丢掉中间的消息
+  if (overflow) {
+    if (!_pimpl->_isClosed.load(std::memory_order_relaxed)) {
+      logger.error("Session {} send queue reached {} messages, closing", _pimpl->_uuid, SEND_QUEUE_MAX_LEN);
+      boost::asio::post(_pimpl->_ioc, [self = shared_from_this()]() -> void {
+        self->_pimpl->close();
+      });
     }
-    _pimpl->_send_queue.emplace(send_node);
+    return;
   }
 
   if (should_start_coroutine) {
     boost::asio::co_spawn(_pimpl->_ioc, [self = shared_from_this()]() -> boost::asio::awaitable<void> {
       try {
         while (true) {
-          std::shared_ptr<SendNode> node;
+          std::shared_ptr<const SendNode> send_node;
           {
             std::lock_guard<std::mutex> lock{self->_pimpl->_send_mtx};
             if (self->_pimpl->_send_queue.empty()) {
               co_return;
             }
-            node = std::move(self->_pimpl->_send_queue.front());
+            send_node = std::move(self->_pimpl->_send_queue.front());
             self->_pimpl->_send_queue.pop();
           }
           co_await boost::asio::async_write(self->_pimpl->_socket,
-            boost::asio::buffer(node->_data, static_cast<size_t>(node->_msg_len)),
+            boost::asio::buffer(send_node->_data, static_cast<size_t>(send_node->_msg_len)),
             boost::asio::use_awaitable);
+
+          // 先释放节点，最后一个引用时全局预算随之归还，再判断能否恢复读取
+          const auto sent_len = static_cast<std::size_t>(send_node->_msg_len);
+          send_node.reset();
+          self->_pimpl->_send_count.fetch_sub(1, std::memory_order_relaxed);
+          self->_pimpl->_send_bytes.fetch_sub(sent_len, std::memory_order_relaxed);
+          self->_pimpl->tryResume(self);
           }
       } catch (const boost::system::system_error &err) {
         logger.error("Session send error: {}", err.code().message());
@@ -153,6 +313,33 @@ void Session::Send(short msgType, short msgLen, const char *msgBody) {
 
 }
 
+void Session::SetCompression(CompressAlgo algo) {
+  _pimpl->_compress_algo.store(algo, std::memory_order_relaxed);
+}
+
+bool Session::PostLocal(std::shared_ptr<RecvNode> node) {
+  // 本地会话没有读协程可暂停，只看所有入口共享的逻辑队列和全局预算
+  if (logicSystem.QueueSize() >= RECV_QUEUE_MAX_LEN || memoryBudget.OverBudget()) {
+    return false;
+  }
+
+  _pimpl->_logic_inflight.fetch_add(1, std::memory_order_relaxed);
+  memoryBudget.Acquire(static_cast<std::size_t>(node->_msg_len));
+  logicSystem.PostMsgToLogicQueue(std::make_shared<LogicNode>(shared_from_this(), std::move(node)));
+  return true;
+}
+
+void Session::LogicDone(std::size_t msgLen, std::uint32_t reqId) {
+  _pimpl->_logic_inflight.fetch_sub(1, std::memory_order_relaxed);
+  memoryBudget.Release(msgLen);
+
+  if (_pimpl->_peer != nullptr) {
+    _pimpl->_peer->OnLogicDone(reqId);
+    return;
+  }
+  _pimpl->tryResume(shared_from_this());
+}
+
 std::string &Session::getUuid() const {
   return _pimpl->_uuid;
 }
@@ -161,4 +348,8 @@ boost::asio::ip::tcp::socket &Session::getSocket() {
   return _pimpl->_socket;
 }
 
+boost::asio::io_context &Session::getIoContext() {
+  return _pimpl->_ioc;
+}
+
 } // namespace core
\ No newline at end of file
@@ -12,6 +12,8 @@
 #define SESSION_HPP
 
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 
 #include <core/CoreExport.hpp>
 
@@ -21,17 +23,52 @@
 namespace core {
 
 class Server;
+class SendNode;
+class RecvNode;
+enum class CompressAlgo : std::uint8_t;
+
+/**
+  * @brief 本地会话的对端，进程内的其它入口(如gRPC网关)借助它复用逻辑系统的消息处理
+  * @details 两个回调都在逻辑线程上执行，不要在其中阻塞
+  **/
+class CORE_EXPORT LocalPeer {
+public:
+  virtual ~LocalPeer() = default;
+
+  // 逻辑线程经由会话发出的消息，消息体未压缩，不含头部
+  virtual void OnSend(short msgType, const char *msgBody, short msgLen, std::uint32_t reqId) = 0;
+
+  // 一条消息处理完毕，处理函数的回复都已经在此之前发出
+  virtual void OnLogicDone(std::uint32_t reqId) = 0;
+};
+
 class CORE_EXPORT Session : public std::enable_shared_from_this<Session>  {
 public:
   Session(boost::asio::io_context &ioc, Server *server);
 
+  // 进程内的本地会话，没有套接字，发出的消息和处理完成通知直接交给peer，peer需要比会话活得久
+  Session(boost::asio::io_context &ioc, LocalPeer *peer);
+
   ~Session();
 
   void Read();
-  void Send(short msgType, short msgLen, const char *msgBody);
+  void Send(short msgType, short msgLen, const char *msgBody, std::uint32_t reqId = 0);
+
+  // 发送已经序列化好的节点，节点只读，可被多个会话的发送队列共享；由memoryBudget.MakeSendNode创建的节点全局预算只计一次
+  void Send(std::shared_ptr<const SendNode> node);
+
+  // 协商成功后，此后逻辑线程发出的消息体超过阈值即压缩
+  void SetCompression(CompressAlgo algo);
+
+  // 本地会话把一条消息直接投递到逻辑队列，逻辑队列积压或全局预算用尽时返回false
+  bool PostLocal(std::shared_ptr<RecvNode> node);
+
+  // 逻辑线程处理完一条消息后调用，低于水位时恢复读取
+  void LogicDone(std::size_t msgLen, std::uint32_t reqId = 0);
 
   std::string &getUuid() const;
   boost::asio::ip::tcp::socket &getSocket();
+  boost::asio::io_context &getIoContext();
 
 private:
   struct _impl;
@@ -0,0 +1,460 @@
+#include "ConnectionPool.hpp"
+
+#include <mutex>
+#include <queue>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include <sstream>
+#include <cstdint>
+#include <unordered_map>
+
+#include <global/Global.hpp>
+#include <middleware/Logger.hpp>
+#include <core/dns/DnsCache.hpp>
+#include <core/io-pool/IoPool.hpp>
+#include <core/msg-node/MsgNode.hpp>
+
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/detail/socket_holder.hpp>
+
+namespace core {
+
+using Clock = std::chrono::steady_clock;
+
+class Upstream;
+
+// 一条到后端的长连接，所有状态只在所属的io线程上访问
+class UpstreamConnection : public std::enable_shared_from_this<UpstreamConnection> {
+public:
+  enum class State : std::uint8_t { CONNECTING, CONNECTED, CLOSED };
+
+  UpstreamConnection(boost::asio::io_context &ioc, const std::shared_ptr<Upstream> &upstream)
+    : _ioc(ioc), _socket(ioc), _ping_timer(ioc), _upstream(upstream) {}
+
+  void Start();
+
+  // 任意线程调用，投递到所属io线程上排队发送
+  void Call(short msgType, std::string body, ConnectionPool::Callback callback) {
+    _in_flight.fetch_add(1, std::memory_order_relaxed);
+    boost::asio::post(_ioc, [self = shared_from_this(), msgType, body = std::move(body), callback = std::move(callback)]() mutable -> void {
+      self->send(msgType, body, std::move(callback), std::chrono::milliseconds(UPSTREAM_CALL_TIMEOUT_MS));
+    });
+  }
+
+  [[nodiscard]] std::size_t InFlight() const { return _in_flight.load(std::memory_order_relaxed); }
+  [[nodiscard]] State getState() const { return _state.load(std::memory_order_acquire); }
+
+private:
+  // timeout为0时不设截止时间，心跳由keepalive自己判断超时
+  void send(short msgType, const std::string &body, ConnectionPool::Callback callback, std::chrono::milliseconds timeout);
+  void expire(std::uint32_t reqId);
+  void close(const boost::system::error_code &err);
+
+  boost::asio::awaitable<void> connect();
+  boost::asio::awaitable<void> reader();
+  boost::asio::awaitable<void> writer();
+  boost::asio::awaitable<void> keepalive();
+
+  boost::asio::io_context &_ioc;
+  boost::asio::ip::tcp::socket _socket;
+  boost::asio::steady_timer _ping_timer;
+  std::weak_ptr<Upstream> _upstream;
+
+  std::atomic<State> _state{State::CONNECTING};
+  std::atomic<std::size_t> _in_flight{0};
+
+  // 在途请求，带截止时间的请求各自持有一个定时器，请求完成或连接关闭时随之销毁并取消
+  struct Pending {
+    ConnectionPool::Callback _callback;
+    std::unique_ptr<boost::asio::steady_timer> _deadline;
+  };
+
+  std::uint32_t _next_req_id{1};
+  std::unordered_map<std::uint32_t, Pending> _pending;
+  std::queue<std::shared_ptr<const SendNode>> _send_queue;
+  bool _writing{false};
+
+  Clock::time_point _last_active{Clock::now()};
+  bool _ping_outstanding{false};
+};
+
+// 熔断器: 连续失败达到阈值后打开，打开期间直接拒绝请求，
+// 到期后半开，只放一条试探连接，连上则关闭熔断，失败则重新打开
+enum class BreakerState : std::uint8_t { CLOSED, OPEN, HALF_OPEN };
+
+class Upstream : public std::enable_shared_from_this<Upstream> {
+public:
+  Upstream(std::string host, std::string port) : _host(std::move(host)), _port(std::move(port)) {}
+
+  // 选出在途请求最少的连接，所有连接都忙且未满时新建一条
+  std::shared_ptr<UpstreamConnection> Pick(boost::system::error_code &err) {
+    std::shared_ptr<UpstreamConnection> created;
+    std::shared_ptr<UpstreamConnection> best;
+
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      std::erase_if(_conns, [](const auto &conn) -> bool { return conn->getState() == UpstreamConnection::State::CLOSED; });
+
+      if (_breaker == BreakerState::OPEN) {
+        if (Clock::now() < _open_until) {
+          err = boost::asio::error::connection_refused;
+          return nullptr;
+        }
+        _breaker = BreakerState::HALF_OPEN;
+        logger.info("Upstream {}:{} circuit half-open", _host, _port);
+      }
+
+      for (const auto &conn : _conns) {
+        if (!best || conn->InFlight() < best->InFlight()) {
+          best = conn;
+        }
+      }
+
+      bool can_grow = _breaker == BreakerState::CLOSED ? _conns.size() < UPSTREAM_POOL_SIZE : _conns.empty();
+      if (can_grow && (!best || best->InFlight() > 0)) {
+        created = std::make_shared<UpstreamConnection>(ioPool.getIoContext(), shared_from_this());
+        _conns.emplace_back(created);
+        best = created;
+      }
+    }
+
+    if (created) {
+      created->Start();
+    }
+    return best;
+  }
+
+  void OnConnected() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    if (_breaker != BreakerState::CLOSED) {
+      logger.info("Upstream {}:{} circuit closed", _host, _port);
+    }
+    _breaker = BreakerState::CLOSED;
+    _failures = 0;
+  }
+
+  void OnFailure() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    ++_total_failures;
+    if (_breaker == BreakerState::HALF_OPEN || ++_failures >= UPSTREAM_BREAKER_FAILURES) {
+      if (_breaker != BreakerState::OPEN) {
+        logger.warning("Upstream {}:{} circuit open after {} failures", _host, _port, _failures);
+      }
+      _breaker = BreakerState::OPEN;
+      _open_until = Clock::now() + std::chrono::milliseconds(UPSTREAM_BREAKER_OPEN_MS);
+    }
+  }
+
+  void Report(std::ostringstream &oss) {
+    static constexpr const char *breaker_names[] = {"closed", "open", "half-open"};
+    std::lock_guard<std::mutex> lock{_mutex};
+    std::size_t in_flight = 0;
+    for (const auto &conn : _conns) {
+      in_flight += conn->InFlight();
+    }
+    oss << _host << ':' << _port << " conns: " << _conns.size() << ", in flight: " << in_flight
+        << ", circuit: " << breaker_names[static_cast<std::size_t>(_breaker)] << ", failures: " << _total_failures << '\n';
+  }
+
+  [[nodiscard]] const std::string &Host() const { return _host; }
+  [[nodiscard]] const std::string &Port() const { return _port; }
+
+private:
+  std::string _host;
+  std::string _port;
+
+  std::mutex _mutex;
+  std::vector<std::shared_ptr<UpstreamConnection>> _conns;
+
+  BreakerState _breaker{BreakerState::CLOSED};
+  std::size_t _failures{0};
+  std::size_t _total_failures{0};
+  Clock::time_point _open_until;
+};
+
+void UpstreamConnection::Start() {
+  boost::asio::co_spawn(_ioc, [self = shared_from_this()]() -> boost::asio::awaitable<void> {
+    co_await self->connect();
+  }, boost::asio::detached);
+}
+
+boost::asio::awaitable<void> UpstreamConnection::connect() {
+  auto upstream = _upstream.lock();
+  if (!upstream) {
+    co_return;
+  }
+
+  boost::system::error_code err;
+  auto endpoints = co_await dnsCache.AsyncResolve(upstream->Host(), upstream->Port(), boost::asio::redirect_error(boost::asio::use_awaitable, err));
+
+  // 超时后关闭socket使连接操作以operation_aborted结束，已连上时定时器回调什么也不做
+  auto timed_out = std::make_shared<bool>(false);
+  if (!err) {
+    boost::asio::steady_timer deadline{_ioc};
+    deadline.expires_after(std::chrono::milliseconds(UPSTREAM_CONNECT_TIMEOUT_MS));
+    deadline.async_wait([self = shared_from_this(), timed_out](const boost::system::error_code &errc) -> void {
+      if (!errc && self->getState() == State::CONNECTING) {
+        *timed_out = true;
+        boost::system::error_code ignored;
+        self->_socket.close(ignored);
+      }
+    });
+    co_await boost::asio::async_connect(_socket, endpoints, boost::asio::redirect_error(boost::asio::use_awaitable, err));
+    deadline.cancel();
+  }
+
+  if (err) {
+    if (*timed_out) {
+      err = boost::asio::error::timed_out;
+    }
+    logger.error("Connect to upstream {}:{} failed: {}", upstream->Host(), upstream->Port(), err.message());
+    upstream->OnFailure();
+    close(err);
+    co_return;
+  }
+
+  _socket.set_option(boost::asio::ip::tcp::no_delay{true});
+  _state.store(State::CONNECTED, std::memory_order_release);
+  upstream->OnConnected();
+
+  auto self = shared_from_this();
+  boost::asio::co_spawn(_ioc, [self]() -> boost::asio::awaitable<void> { co_await self->reader(); }, boost::asio::detached);
+  boost::asio::co_spawn(_ioc, [self]() -> boost::asio::awaitable<void> { co_await self->keepalive(); }, boost::asio::detached);
+  if (!_send_queue.empty() && !_writing) {
+    _writing = true;
+    boost::asio::co_spawn(_ioc, [self]() -> boost::asio::awaitable<void> { co_await self->writer(); }, boost::asio::detached);
+  }
+}
+
+void UpstreamConnection::send(short msgType, const std::string &body, ConnectionPool::Callback callback, std::chrono::milliseconds timeout) {
+  if (_state.load(std::memory_order_acquire) == State::CLOSED) {
+    _in_flight.fetch_sub(1, std::memory_order_relaxed);
+    callback(boost::asio::error::not_connected, {});
+    return;
+  }
+
+  // 请求id为0表示不带id，跳过
+  std::uint32_t req_id = _next_req_id++;
+  if (req_id == 0) {
+    req_id = _next_req_id++;
+  }
+  auto &pending = _pending[req_id];
+  pending._callback = std::move(callback);
+  if (timeout.count() > 0) {
+    pending._deadline = std::make_unique<boost::asio::steady_timer>(_ioc, timeout);
+    pending._deadline->async_wait([weak = weak_from_this(), req_id](const boost::system::error_code &errc) -> void {
+      if (auto self = weak.lock(); self && !errc) {
+        self->expire(req_id);
+      }
+    });
+  }
+  _send_queue.emplace(std::make_shared<const SendNode>(msgType, static_cast<short>(body.size()), body.data(), req_id));
+
+  // 连接建立前只排队，连上后由connect启动写协程
+  if (!_writing && _state.load(std::memory_order_acquire) == State::CONNECTED) {
+    _writing = true;
+    boost::asio::co_spawn(_ioc, [self = shared_from_this()]() -> boost::asio::awaitable<void> { co_await self->writer(); }, boost::asio::detached);
+  }
+}
+
+boost::asio::awaitable<void> UpstreamConnection::writer() {
+  boost::system::error_code err;
+  while (!_send_queue.empty() && _state.load(std::memory_order_acquire) == State::CONNECTED) {
+    auto node = _send_queue.front();
+    co_await boost::asio::async_write(_socket, boost::asio::buffer(node->_data, static_cast<std::size_t>(node->_msg_len)),
+                                      boost::asio::redirect_error(boost::asio::use_awaitable, err));
+    if (err) {
+      close(err);
+      break;
+    }
+    _send_queue.pop();
+  }
+  _writing = false;
+}
+
+// 与Session相同的分帧: 2字节类型 + 2字节长度 + 可选的4字节请求id + 消息体
+boost::asio::awaitable<void> UpstreamConnection::reader() {
+  boost::system::error_code err;
+  char head[MSG_HEAD_TOTAL_LEN + MSG_REQ_ID_LENGTH];
+  std::string body;
+
+  while (_state.load(std::memory_order_acquire) == State::CONNECTED) {
+    co_await boost::asio::async_read(_socket, boost::asio::buffer(head, MSG_HEAD_TOTAL_LEN), boost::asio::redirect_error(boost::asio::use_awaitable, err));
+    if (err) {
+      break;
+    }
+
+    u_short raw_type = 0;
+    u_short msg_len = 0;
+    memcpy(&raw_type, head, MSG_TYPE_LENGTH);
+    memcpy(&msg_len, head + MSG_TYPE_LENGTH, MSG_LEN_LENGTH);
+    raw_type = boost::asio::detail::socket_ops::network_to_host_short(raw_type);
+    msg_len = boost::asio::detail::socket_ops::network_to_host_short(msg_len);
+    if (msg_len > MSG_BODY_LENGTH) {
+      err = boost::asio::error::message_size;
+      break;
+    }
+
+    std::uint32_t req_id = 0;
+    if ((raw_type & MSG_REQ_ID_FLAG) != 0) {
+      co_await boost::asio::async_read(_socket, boost::asio::buffer(&req_id, MSG_REQ_ID_LENGTH), boost::asio::redirect_error(boost::asio::use_awaitable, err));
+      if (err) {
+        break;
+      }
+      req_id = static_cast<std::uint32_t>(boost::asio::detail::socket_ops::network_to_host_long(req_id));
+    }
+
+    body.resize(msg_len);
+    co_await boost::asio::async_read(_socket, boost::asio::buffer(body), boost::asio::redirect_error(boost::asio::use_awaitable, err));
+    if (err) {
+      break;
+    }
+    _last_active = Clock::now();
+
+    auto iter = _pending.find(req_id);
+    if (iter == _pending.end()) {
+      logger.warning("Upstream response with unknown request id: {}", req_id);
+      continue;
+    }
+    auto callback = std::move(iter->second._callback);
+    _pending.erase(iter);
+    _in_flight.fetch_sub(1, std::memory_order_relaxed);
+    callback({}, UpstreamResponse{static_cast<short>(raw_type & MSG_TYPE_MASK), body});
+  }
+
+  if (err && err != boost::asio::error::operation_aborted) {
+    logger.error("Upstream connection read error: {}", err.message());
+    if (auto upstream = _upstream.lock(); upstream && !_pending.empty()) {
+      upstream->OnFailure();
+    }
+  }
+  close(err ? err : boost::asio::error::operation_aborted);
+}
+
+// 空闲超过一个心跳间隔时发心跳，上一次心跳在一个间隔内没有响应则认为连接已失效
+boost::asio::awaitable<void> UpstreamConnection::keepalive() {
+  boost::system::error_code err;
+  const auto interval = std::chrono::milliseconds(UPSTREAM_PING_INTERVAL_MS);
+
+  while (_state.load(std::memory_order_acquire) == State::CONNECTED) {
+    _ping_timer.expires_after(interval);
+    co_await _ping_timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, err));
+    if (err || _state.load(std::memory_order_acquire) != State::CONNECTED) {
+      co_return;
+    }
+
+    if (_ping_outstanding) {
+      logger.warning("Upstream heartbeat timeout, close the connection");
+      if (auto upstream = _upstream.lock()) {
+        upstream->OnFailure();
+      }
+      close(boost::asio::error::timed_out);
+      co_return;
+    }
+
+    if (Clock::now() - _last_active >= interval) {
+      _ping_outstanding = true;
+      _in_flight.fetch_add(1, std::memory_order_relaxed);
+      send(static_cast<short>(MSG_TYPE::MSG_HEARTBEAT), {}, [weak = weak_from_this()](const boost::system::error_code &errc, const UpstreamResponse &) -> void {
+        if (auto self = weak.lock(); self && !errc) {
+          self->_ping_outstanding = false;
+        }
+      }, std::chrono::milliseconds::zero());
+    }
+  }
+}
+
+// 后端仍回心跳却迟迟不回某个请求时，连接不会被关闭，只能靠请求自己的截止时间结束它，并计入熔断；
+// 之后迟到的响应按未知请求id丢弃
+void UpstreamConnection::expire(std::uint32_t reqId) {
+  auto iter = _pending.find(reqId);
+  if (iter == _pending.end()) {
+    return;
+  }
+  auto callback = std::move(iter->second._callback);
+  _pending.erase(iter);
+  _in_flight.fetch_sub(1, std::memory_order_relaxed);
+
+  if (auto upstream = _upstream.lock()) {
+    logger.warning("Upstream {}:{} request {} timed out", upstream->Host(), upstream->Port(), reqId);
+    upstream->OnFailure();
+  }
+  callback(boost::asio::error::timed_out, {});
+}
+
+void UpstreamConnection::close(const boost::system::error_code &err) {
+  if (_state.exchange(State::CLOSED, std::memory_order_acq_rel) == State::CLOSED) {
+    return;
+  }
+
+  boost::system::error_code ignored;
+  _socket.close(ignored);
+  _ping_timer.cancel();
+
+  // 连接上所有未完成的请求都以错误结束，由调用方决定是否重试
+  auto pending = std::move(_pending);
+  _pending.clear();
+  _send_queue = {};
+  _in_flight.fetch_sub(pending.size(), std::memory_order_relaxed);
+  for (auto &[req_id, request] : pending) {
+    request._callback(err, {});
+  }
+}
+
+struct ConnectionPool::_impl {
+  mutable std::mutex _mutex;
+  std::unordered_map<std::string, std::shared_ptr<Upstream>> _upstreams;
+
+  std::shared_ptr<Upstream> getUpstream(const std::string &host, const std::string &port) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto &upstream = _upstreams[host + ':' + port];
+    if (!upstream) {
+      upstream = std::make_shared<Upstream>(host, port);
+    }
+    return upstream;
+  }
+};
+
+// 连接跑在ioPool的io_context上，先构造ioPool使其晚于连接池析构
+ConnectionPool::ConnectionPool() : _pimpl(std::make_unique<_impl>()) {
+  static_cast<void>(ioPool);
+}
+
+ConnectionPool::~ConnectionPool() {
+  logger.debug("The connection pool has been released!");
+}
+
+void ConnectionPool::call(std::string host, std::string port, short msgType, std::string body, Callback callback) {
+  auto upstream = _pimpl->getUpstream(host, port);
+
+  boost::system::error_code err;
+  auto conn = upstream->Pick(err);
+  if (!conn) {
+    callback(err, {});
+    return;
+  }
+  conn->Call(msgType, std::move(body), std::move(callback));
+}
+
+std::string ConnectionPool::Report() const {
+  std::ostringstream oss;
+  std::lock_guard<std::mutex> lock{_pimpl->_mutex};
+  for (const auto &[key, upstream] : _pimpl->_upstreams) {
+    upstream->Report(oss);
+  }
+  return oss.str();
+}
+
+} // namespace core
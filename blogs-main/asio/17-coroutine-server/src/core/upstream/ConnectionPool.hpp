@@ -0,0 +1,85 @@
+/******************************************************************************
+ *
+ * @file       ConnectionPool.hpp
+ * @brief      后端之间调用使用的出站连接池，按目标地址复用长连接
+ *
+ * @author     KBchulan
+ * @date       2026/10/19
+ * @history
+ ******************************************************************************/
+
+#ifndef CONNECTIONPOOL_HPP
+#define CONNECTIONPOOL_HPP
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <functional>
+
+#include <core/CoreExport.hpp>
+#include <global/Singleton.hpp>
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/system/detail/error_code.hpp>
+
+namespace core {
+
+// 后端的响应，消息体已去掉头部与请求id
+struct UpstreamResponse {
+  short _msg_id{0};
+  std::string _body;
+};
+
+class CORE_EXPORT ConnectionPool final : public global::Singleton<ConnectionPool> {
+  friend class global::Singleton<ConnectionPool>;
+
+public:
+  using Callback = std::function<void(const boost::system::error_code &, UpstreamResponse)>;
+
+private:
+  ConnectionPool();
+
+public:
+  ~ConnectionPool();
+
+  /**
+    * @brief 向后端发送一条请求并等待响应，请求带请求id，同一连接上可以有多个在途请求
+    * @param host 后端主机名，经由dnsCache解析
+    * @param port 后端端口
+    * @param msgType 消息类型
+    * @param body 消息体
+    * @param token 完成令牌，签名为 void(error_code, UpstreamResponse)；UPSTREAM_CALL_TIMEOUT_MS内未收到响应时以timed_out完成，并计入该后端的熔断失败数
+    **/
+  template <typename CompletionToken>
+  auto AsyncCall(std::string host, std::string port, short msgType, std::string body, CompletionToken &&token) {
+    return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code, UpstreamResponse)>(
+      [this](auto handler, std::string h, std::string p, short type, std::string b) -> void {
+        auto work = boost::asio::make_work_guard(handler);
+        auto shared = std::make_shared<decltype(handler)>(std::move(handler));
+        call(std::move(h), std::move(p), type, std::move(b), [shared, work = std::move(work)](const boost::system::error_code &err, UpstreamResponse response) mutable -> void {
+          auto executor = work.get_executor();
+          boost::asio::post(executor, [shared, err, response = std::move(response)]() mutable -> void { (*shared)(err, std::move(response)); });
+          work.reset();
+        });
+      },
+      token, std::move(host), std::move(port), msgType, std::move(body));
+  }
+
+  // 各个后端的连接数、在途请求数与熔断状态
+  [[nodiscard]] std::string Report() const;
+
+private:
+  void call(std::string host, std::string port, short msgType, std::string body, Callback callback);
+
+  struct _impl;
+  std::unique_ptr<_impl> _pimpl;
+};
+
+} // namespace core
+
+#define connectionPool core::ConnectionPool::getInstance()
+
+#endif // CONNECTIONPOOL_HPP
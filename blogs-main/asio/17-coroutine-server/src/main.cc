@@ -1,8 +1,19 @@
 #include <middleware/Logger.hpp>
 #include <core/server/Server.hpp>
+#include <core/compress/Compressor.hpp>
+#include <core/flow-control/RateLimiter.hpp>
+#include <global/Global.hpp>
 #include <boost/asio/signal_set.hpp>
 
-int main() {
+#include <memory>
+#include <string_view>
+
+#ifdef USE_GRPC_GATEWAY
+#include <core/gateway/GrpcGateway.hpp>
+#endif
+
+// 用法: CMakeTemplate [gateway]，gateway模式在同一进程内再开一个gRPC入口
+int main(int argc, char *argv[]) {
   try {
     boost::asio::io_context ioc;
 
@@ -16,8 +27,37 @@ int main() {
       }
     });
 
+    // 会话整体默认不限流，需要时在这里调用SetSessionPolicy；发布消息会扇出给所有订阅者，单独限流，超限直接丢弃
+    core::RateLimiter::SetMsgPolicy(static_cast<short>(MSG_TYPE::MSG_TOPIC_PUBLISH),
+      core::RateLimitPolicy{100, 200, core::RateLimitAction::REJECT});
+
     core::Server server(ioc, 10088);
+
+#ifdef USE_GRPC_GATEWAY
+    // gRPC调用直接转成逻辑系统的消息，与TCP会话共用逻辑线程和全局预算
+    std::unique_ptr<core::GrpcGateway> gateway;
+    if (argc > 1 && std::string_view{argv[1]} == "gateway") {
+      gateway = std::make_unique<core::GrpcGateway>(GATEWAY_GRPC_ADDRESS, GATEWAY_CQ_COUNT);
+      core::RegisterHelloRoutes(*gateway);
+      if (!gateway->Start()) {
+        gateway.reset();
+      }
+    }
+#else
+    if (argc > 1 && std::string_view{argv[1]} == "gateway") {
+      logger.warning("Built without USE_GRPC_GATEWAY, gateway mode is ignored");
+    }
+#endif
+
     ioc.run();
+
+#ifdef USE_GRPC_GATEWAY
+    if (gateway) {
+      gateway->Shutdown();
+    }
+#endif
+
+    logger.info("Compression stats: {}", compressor.Report());
   } catch (const boost::system::error_code& err) {
     logger.error("error code is: {}", err.value());
   }
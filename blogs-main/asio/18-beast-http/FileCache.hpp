@@ -0,0 +1,220 @@
+#ifndef FILECACHE_HPP
+#define FILECACHE_HPP
+
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+// 小于该大小的文件整体缓存在内存中，更大的文件用file_body分块读出
+#define FILE_CACHE_MAX_FILE_SIZE 1024 * 64
+// 缓存的总字节数上限，满了之后新文件不再进入缓存
+#define FILE_CACHE_CAPACITY 1024 * 1024 * 64
+
+// 响应体直接引用缓存中的不可变数据，所有连接共享同一份，写出时不再拷贝
+struct SharedBody {
+  using value_type = std::shared_ptr<const std::string>;
+
+  static std::uint64_t size(const value_type &body) {
+    return body ? body->size() : 0;
+  }
+
+  class writer {
+  public:
+    using const_buffers_type = boost::asio::const_buffer;
+
+    template <bool isRequest, class Fields>
+    writer(const boost::beast::http::header<isRequest, Fields> &, const value_type &body) : _body(body) {}
+
+    void init(boost::beast::error_code &errc) {
+      errc = {};
+    }
+
+    boost::optional<std::pair<const_buffers_type, bool>> get(boost::beast::error_code &errc) {
+      errc = {};
+      if (!_body || _body->empty()) {
+        return boost::none;
+      }
+      return std::make_pair(boost::asio::const_buffer(_body->data(), _body->size()), false);
+    }
+
+  private:
+    const value_type &_body;
+  };
+};
+
+// 文件的元信息，ETag由大小和修改时间得出，不需要读文件内容
+struct FileInfo {
+  std::filesystem::path _path;
+  std::uint64_t _size{0};
+  std::filesystem::file_time_type _mtime;
+  std::string _etag;
+  std::string_view _content_type;
+};
+
+struct CachedFile {
+  FileInfo _info;
+  std::shared_ptr<const std::string> _data;
+};
+
+inline std::string_view mime_type(const std::filesystem::path &path) {
+  static const std::unordered_map<std::string, std::string_view> types{
+    {".html", "text/html"}, {".htm", "text/html"}, {".css", "text/css"}, {".txt", "text/plain"},
+    {".js", "application/javascript"}, {".json", "application/json"}, {".xml", "application/xml"},
+    {".png", "image/png"}, {".jpg", "image/jpeg"}, {".jpeg", "image/jpeg"}, {".gif", "image/gif"},
+    {".svg", "image/svg+xml"}, {".ico", "image/vnd.microsoft.icon"},
+  };
+  auto iter = types.find(path.extension().string());
+  return iter == types.end() ? "application/octet-stream" : iter->second;
+}
+
+class FileCache {
+public:
+  explicit FileCache(std::filesystem::path root) : _root(std::move(root)) {
+    std::error_code errc;
+    _canonical_root = std::filesystem::canonical(_root, errc);
+  }
+
+  /**
+    * @brief 把请求路径映射到根目录下的文件并取得其元信息，拒绝跳出根目录的路径
+    * @details 先按词法规整，拒绝绝对路径和以..开头的路径(如 //etc/passwd 去掉首个/后仍是绝对路径，
+    *          拼接时会整个替换掉根目录)，再解析符号链接，确认实际文件仍在根目录之下
+    * @param target 请求路径，如 /index.html
+    * @return 文件不存在或路径非法时返回空
+    **/
+  std::optional<FileInfo> Stat(std::string_view target) const {
+    if (target.empty() || target.front() != '/' || _canonical_root.empty()) {
+      return std::nullopt;
+    }
+
+    std::filesystem::path relative = std::filesystem::path{target.substr(1)}.lexically_normal();
+    if (relative.is_absolute() || relative.has_root_name() || relative.has_root_directory() ||
+        (!relative.empty() && *relative.begin() == "..")) {
+      return std::nullopt;
+    }
+
+    std::filesystem::path path = _root / relative;
+    std::error_code errc;
+    if (std::filesystem::is_directory(path, errc)) {
+      path /= "index.html";
+    }
+
+    if (!within_root(path)) {
+      return std::nullopt;
+    }
+
+    FileInfo info;
+    info._size = std::filesystem::file_size(path, errc);
+    if (errc) {
+      return std::nullopt;
+    }
+    info._mtime = std::filesystem::last_write_time(path, errc);
+    if (errc) {
+      return std::nullopt;
+    }
+
+    auto ticks = static_cast<std::uint64_t>(info._mtime.time_since_epoch().count());
+    info._etag = std::format("\"{:x}-{:x}\"", info._size, ticks);
+    info._content_type = mime_type(path);
+    info._path = std::move(path);
+    return info;
+  }
+
+  // 小文件返回缓存的内容，修改时间或大小变化时重新读取，大文件返回空由调用方走file_body
+  std::shared_ptr<const std::string> Load(const FileInfo &info) {
+    if (info._size > FILE_CACHE_MAX_FILE_SIZE) {
+      return nullptr;
+    }
+
+    const std::string key = info._path.string();
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      auto iter = _files.find(key);
+      if (iter != _files.end() && iter->second._info._mtime == info._mtime && iter->second._info._size == info._size) {
+        return iter->second._data;
+      }
+    }
+
+    std::ifstream file{info._path, std::ios::binary};
+    if (!file.is_open()) {
+      return nullptr;
+    }
+    auto data = std::make_shared<const std::string>(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto iter = _files.find(key);
+    if (iter != _files.end()) {
+      _bytes -= iter->second._data->size();
+      _files.erase(iter);
+    }
+    if (_bytes + data->size() <= FILE_CACHE_CAPACITY) {
+      _bytes += data->size();
+      _files.emplace(key, CachedFile{info, data});
+    }
+    return data;
+  }
+
+private:
+  // 解析符号链接后逐段比较，不能用字符串前缀判断，否则 /srv/www 会把 /srv/www2 也当成根目录之下
+  bool within_root(const std::filesystem::path &path) const {
+    std::error_code errc;
+    std::filesystem::path resolved = std::filesystem::weakly_canonical(path, errc);
+    if (errc) {
+      return false;
+    }
+    auto [root_iter, path_iter] = std::mismatch(_canonical_root.begin(), _canonical_root.end(), resolved.begin(), resolved.end());
+    return root_iter == _canonical_root.end();
+  }
+
+  std::filesystem::path _root;
+  std::filesystem::path _canonical_root;
+
+  std::mutex _mutex;
+  std::unordered_map<std::string, CachedFile> _files;
+  std::size_t _bytes{0};
+};
+
+// If-None-Match 可能是 *、单个或逗号分隔的多个ETag，弱校验前缀W/忽略
+inline bool etag_matches(std::string_view if_none_match, std::string_view etag) {
+  if (if_none_match == "*") {
+    return true;
+  }
+  while (!if_none_match.empty()) {
+    auto comma = if_none_match.find(',');
+    auto item = if_none_match.substr(0, comma);
+    while (!item.empty() && item.front() == ' ') {
+      item.remove_prefix(1);
+    }
+    if (item.starts_with("W/")) {
+      item.remove_prefix(2);
+    }
+    while (!item.empty() && item.back() == ' ') {
+      item.remove_suffix(1);
+    }
+    if (item == etag) {
+      return true;
+    }
+    if (comma == std::string_view::npos) {
+      break;
+    }
+    if_none_match.remove_prefix(comma + 1);
+  }
+  return false;
+}
+
+#endif // FILECACHE_HPP
@@ -0,0 +1,64 @@
+#ifndef IOPOOL_HPP
+#define IOPOOL_HPP
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// 每个线程各跑一个io_context，连接的所有回调都在接受它的那个线程上执行，无需加锁
+class IoPool {
+public:
+  explicit IoPool(unsigned int size) : _ioContexts(size) {
+    _workGuards.reserve(size);
+    for (auto &io_context : _ioContexts) {
+      _workGuards.emplace_back(boost::asio::make_work_guard(io_context));
+    }
+  }
+
+  // 阻塞直到所有io_context退出
+  void run() {
+    _threads.reserve(_ioContexts.size());
+    for (auto &io_context : _ioContexts) {
+      _threads.emplace_back([&io_context]() -> void {
+        io_context.run();
+      });
+    }
+    _threads.clear();
+  }
+
+  boost::asio::io_context &getIoContext() {
+    return _ioContexts[_index.fetch_add(1, std::memory_order_relaxed) % _ioContexts.size()];
+  }
+
+  boost::asio::io_context &getIoContext(std::size_t index) {
+    return _ioContexts[index % _ioContexts.size()];
+  }
+
+  [[nodiscard]] std::size_t size() const {
+    return _ioContexts.size();
+  }
+
+private:
+  std::vector<boost::asio::io_context> _ioContexts;
+  std::vector<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> _workGuards;
+  std::vector<std::jthread> _threads;
+  std::atomic<std::size_t> _index{0};
+};
+
+// 打开监听socket，支持时设置SO_REUSEPORT，允许每个线程各自绑定同一端口
+inline void listen(boost::asio::ip::tcp::acceptor& acceptor, const boost::asio::ip::tcp::endpoint& endpoint) {
+  acceptor.open(endpoint.protocol());
+  acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+#ifdef SO_REUSEPORT
+  acceptor.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+#endif
+  acceptor.bind(endpoint);
+  acceptor.listen();
+}
+
+#endif // IOPOOL_HPP
@@ -0,0 +1,121 @@
+#ifndef ROUTER_HPP
+#define ROUTER_HPP
+
+#include <boost/beast/http/verb.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 支持string_view直接查找，避免每个请求为了查表构造一次std::string
+struct PathHash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view path) const noexcept {
+    return std::hash<std::string_view>{}(path);
+  }
+};
+
+/**
+  * @brief 路由表: 精确路径用哈希表O(1)匹配，前缀路由(如静态文件目录)按路径分段存在字典树上取最长匹配
+  * @tparam Handler 处理函数类型，路由表只负责查找，不关心如何调用
+  **/
+template <typename Handler>
+class Router {
+public:
+  // 同一路径下不同方法的处理函数
+  struct Methods {
+    std::vector<std::pair<boost::beast::http::verb, Handler>> _handlers;
+
+    const Handler *find(boost::beast::http::verb method) const {
+      for (const auto &[verb, handler] : _handlers) {
+        if (verb == method) {
+          return &handler;
+        }
+      }
+      return nullptr;
+    }
+  };
+
+  // 查找结果: 路径不存在 / 路径存在但方法不支持 / 命中
+  struct Match {
+    const Methods *_methods{nullptr};
+    const Handler *_handler{nullptr};
+  };
+
+  void Add(boost::beast::http::verb method, std::string path, Handler handler) {
+    _exact[std::move(path)]._handlers.emplace_back(method, std::move(handler));
+  }
+
+  // 前缀按"/"分段匹配，"/static"能匹配"/static/a.css"，但不匹配"/staticx"
+  void AddPrefix(boost::beast::http::verb method, std::string_view prefix, Handler handler) {
+    Node *node = &_root;
+    for_each_segment(prefix, [&node](std::string_view segment) -> bool {
+      auto &child = node->_children[std::string{segment}];
+      if (!child) {
+        child = std::make_unique<Node>();
+      }
+      node = child.get();
+      return true;
+    });
+    node->_methods._handlers.emplace_back(method, std::move(handler));
+  }
+
+  // 路径中不应包含查询串，由调用方先去掉
+  Match Find(boost::beast::http::verb method, std::string_view path) const {
+    if (auto iter = _exact.find(path); iter != _exact.end()) {
+      return {&iter->second, iter->second.find(method)};
+    }
+
+    const Node *node = &_root;
+    const Methods *longest = _root._methods._handlers.empty() ? nullptr : &_root._methods;
+    for_each_segment(path, [&node, &longest](std::string_view segment) -> bool {
+      auto iter = node->_children.find(segment);
+      if (iter == node->_children.end()) {
+        return false;
+      }
+      node = iter->second.get();
+      if (!node->_methods._handlers.empty()) {
+        longest = &node->_methods;
+      }
+      return true;
+    });
+
+    if (longest == nullptr) {
+      return {};
+    }
+    return {longest, longest->find(method)};
+  }
+
+private:
+  struct Node {
+    std::unordered_map<std::string, std::unique_ptr<Node>, PathHash, std::equal_to<>> _children;
+    Methods _methods;
+  };
+
+  // 依次回调每个非空路径段，回调返回false时停止
+  template <typename Fn>
+  static void for_each_segment(std::string_view path, Fn &&func) {
+    while (!path.empty()) {
+      auto slash = path.find('/');
+      auto segment = path.substr(0, slash);
+      if (!segment.empty() && !func(segment)) {
+        return;
+      }
+      if (slash == std::string_view::npos) {
+        return;
+      }
+      path.remove_prefix(slash + 1);
+    }
+  }
+
+  std::unordered_map<std::string, Methods, PathHash, std::equal_to<>> _exact;
+  Node _root;
+};
+
+#endif // ROUTER_HPP
@@ -0,0 +1,112 @@
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// HTTP压测: 每请求一个连接 vs 长连接 vs 长连接流水线
+// 用法: bench [close|keepalive|pipeline] [线程数] [每线程请求数] [流水线深度] [路径]
+
+using Clock = std::chrono::steady_clock;
+namespace http = boost::beast::http;
+
+std::mutex result_mtx;
+std::vector<double> latencies_us;
+int failed = 0;
+
+http::request<http::empty_body> make_request(const std::string &target, bool keep_alive) {
+  http::request<http::empty_body> req{http::verb::get, target, 11};
+  req.set(http::field::host, "127.0.0.1");
+  req.keep_alive(keep_alive);
+  return req;
+}
+
+void worker(std::string_view mode, int requests, int depth, const std::string &target) {
+  boost::asio::io_context ioc;
+  boost::asio::ip::tcp::resolver resolver{ioc};
+  auto endpoints = resolver.resolve("127.0.0.1", "10088");
+  boost::asio::ip::tcp::socket sock{ioc};
+  boost::beast::flat_buffer buffer;
+  std::vector<double> local;
+  local.reserve(static_cast<std::size_t>(requests));
+  int errors = 0;
+
+  try {
+    if (mode != "close") {
+      boost::asio::connect(sock, endpoints);
+      sock.set_option(boost::asio::ip::tcp::no_delay{true});
+    }
+
+    // close模式每次都新建连接，pipeline模式一次写出depth个请求再依次读回
+    const int batch = mode == "pipeline" ? depth : 1;
+    for (int sent = 0; sent < requests; sent += batch) {
+      auto start = Clock::now();
+      if (mode == "close") {
+        sock = boost::asio::ip::tcp::socket{ioc};
+        boost::asio::connect(sock, endpoints);
+        buffer.clear();
+      }
+
+      for (int i = 0; i < batch; ++i) {
+        http::write(sock, make_request(target, mode != "close"));
+      }
+      for (int i = 0; i < batch; ++i) {
+        http::response<http::string_body> res;
+        http::read(sock, buffer, res);
+        if (res.result() != http::status::ok) {
+          ++errors;
+        }
+      }
+
+      double elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+      for (int i = 0; i < batch; ++i) {
+        local.push_back(elapsed);
+      }
+      if (mode == "close") {
+        boost::beast::error_code errc;
+        sock.shutdown(boost::asio::ip::tcp::socket::shutdown_both, errc);
+        sock.close(errc);
+      }
+    }
+  } catch (const boost::system::system_error &err) {
+    std::cout << "worker error: " << err.what() << '\n';
+    ++errors;
+  }
+
+  std::lock_guard<std::mutex> lock{result_mtx};
+  latencies_us.insert(latencies_us.end(), local.begin(), local.end());
+  failed += errors;
+}
+
+int main(int argc, char *argv[]) {
+  std::string_view mode = argc > 1 ? argv[1] : "keepalive";
+  int thread_count = argc > 2 ? std::atoi(argv[2]) : 8;
+  int requests = argc > 3 ? std::atoi(argv[3]) : 5000;
+  int depth = argc > 4 ? std::max(1, std::atoi(argv[4])) : 8;
+  std::string target = argc > 5 ? argv[5] : "/index.html";
+
+  auto start = Clock::now();
+  {
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < thread_count; ++i) {
+      threads.emplace_back(worker, mode, requests, depth, std::cref(target));
+    }
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::sort(latencies_us.begin(), latencies_us.end());
+  auto percentile = [](double pct) -> double {
+    return latencies_us.empty() ? 0.0 : latencies_us[static_cast<std::size_t>(pct * static_cast<double>(latencies_us.size() - 1))];
+  };
+  std::cout << mode << ": " << static_cast<double>(latencies_us.size()) / seconds << " req/s, p50: " << percentile(0.50)
+            << " us, p99: " << percentile(0.99) << " us, failed: " << failed << '\n';
+}
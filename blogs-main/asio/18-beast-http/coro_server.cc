@@ -0,0 +1,414 @@
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/http/buffer_body.hpp>
+#include <boost/beast/http/chunk_encode.hpp>
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/parser.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/beast/http/string_body.hpp>
+
+#include "FileCache.hpp"
+#include "IoPool.hpp"
+#include "Router.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// 协程版HTTP服务器: 请求体按块交给处理函数，不整体读入内存，上传再大每个连接的内存也是常量
+// 用法: coro_server [静态文件根目录] [线程数]
+
+// 请求行加头部的字节上限，超过返回431
+#define HEADER_LIMIT 1024 * 8
+// 请求体的字节上限，超过返回413
+#define BODY_LIMIT 1024ULL * 1024 * 1024
+// 每次读取请求体、写出分块响应的块大小
+#define BODY_CHUNK_SIZE 1024 * 16
+// 单次读写的超时时间，大文件上传只要一直有数据就不会超时
+#define IO_TIMEOUT_SEC 10
+
+/**
+  * @brief 一次请求/响应的交换: 处理函数通过它分块读取请求体，并写出普通或分块编码的响应
+  * @details 读写出错时只记录错误，之后的读写都直接返回，由会话在处理函数结束后统一关闭连接
+  **/
+class HttpExchange {
+public:
+  HttpExchange(boost::beast::tcp_stream &stream, boost::beast::flat_buffer &buffer,
+               boost::beast::http::request_parser<boost::beast::http::buffer_body> &parser)
+      : _stream(stream), _buffer(buffer), _parser(parser) {}
+
+  [[nodiscard]] const boost::beast::http::request_header<> &Header() const {
+    return _parser.get();
+  }
+
+  // 去掉查询串的请求路径
+  [[nodiscard]] std::string_view Path() const {
+    std::string_view target{_parser.get().target().data(), _parser.get().target().size()};
+    return target.substr(0, target.find('?'));
+  }
+
+  [[nodiscard]] boost::system::error_code Error() const {
+    return _error;
+  }
+
+  [[nodiscard]] bool Responded() const {
+    return _responded;
+  }
+
+  [[nodiscard]] bool KeepAlive() const {
+    return !_error && _parser.is_header_done() && _parser.get().keep_alive();
+  }
+
+  /**
+    * @brief 读取下一块请求体到buf中
+    * @return 读到的字节数，请求体读完或出错时返回0
+    **/
+  boost::asio::awaitable<std::size_t> ReadSome(boost::asio::mutable_buffer buf) {
+    if (_error || _parser.is_done()) {
+      co_return 0;
+    }
+    // 客户端带Expect: 100-continue时，等到处理函数真正要读请求体才让它发送
+    if (!_continued) {
+      _continued = true;
+      if (expects_continue()) {
+        boost::beast::http::response<boost::beast::http::empty_body> res{boost::beast::http::status::continue_, _parser.get().version()};
+        _stream.expires_after(std::chrono::seconds(IO_TIMEOUT_SEC));
+        co_await boost::beast::http::async_write(_stream, res, boost::asio::redirect_error(boost::asio::use_awaitable, _error));
+        if (_error) {
+          co_return 0;
+        }
+      }
+    }
+
+    // 一次read_some可能只解析了分块编码的块头而没有数据，读到数据或结束为止
+    auto &body = _parser.get().body();
+    while (!_parser.is_done()) {
+      body.data = buf.data();
+      body.size = buf.size();
+      boost::system::error_code errc;
+      _stream.expires_after(std::chrono::seconds(IO_TIMEOUT_SEC));
+      co_await boost::beast::http::async_read_some(_stream, _buffer, _parser, boost::asio::redirect_error(boost::asio::use_awaitable, errc));
+      if (errc && errc != boost::beast::http::error::need_buffer) {
+        _error = errc;
+        co_return 0;
+      }
+      if (std::size_t bytes = buf.size() - body.size; bytes > 0) {
+        co_return bytes;
+      }
+    }
+    co_return 0;
+  }
+
+  // 丢弃处理函数没有读完的请求体，下一个请求才能从正确的位置开始解析
+  boost::asio::awaitable<void> Drain() {
+    std::array<char, BODY_CHUNK_SIZE> scratch;
+    while (co_await ReadSome(boost::asio::buffer(scratch)) > 0) {
+    }
+  }
+
+  // 写出完整的响应，响应体类型任意
+  template <class Body>
+  boost::asio::awaitable<void> Write(boost::beast::http::response<Body> &&res) {
+    if (_error) {
+      co_return;
+    }
+    prepare_header(res);
+    if (res.result() != boost::beast::http::status::not_modified) {
+      res.prepare_payload();
+    }
+    _stream.expires_after(std::chrono::seconds(IO_TIMEOUT_SEC));
+    co_await boost::beast::http::async_write(_stream, res, boost::asio::redirect_error(boost::asio::use_awaitable, _error));
+  }
+
+  boost::asio::awaitable<void> Reply(boost::beast::http::status status, std::string_view text) {
+    boost::beast::http::response<boost::beast::http::string_body> res{status, version()};
+    res.set(boost::beast::http::field::content_type, "text/plain");
+    res.body() = text;
+    co_await Write(std::move(res));
+  }
+
+  // 先写出响应头，之后用WriteChunk逐块写出，长度事先未知；HTTP/1.0不支持分块编码，改为以关闭连接结束响应
+  boost::asio::awaitable<void> BeginChunked(boost::beast::http::status status, std::string_view content_type) {
+    if (_error) {
+      co_return;
+    }
+    boost::beast::http::response<boost::beast::http::empty_body> res{status, version()};
+    res.set(boost::beast::http::field::content_type, boost::beast::string_view{content_type.data(), content_type.size()});
+    prepare_header(res);
+    _chunked = version() >= 11;
+    if (_chunked) {
+      res.chunked(true);
+    } else {
+      _close_after = true;
+      res.keep_alive(false);
+    }
+
+    boost::beast::http::response_serializer<boost::beast::http::empty_body> serializer{res};
+    _stream.expires_after(std::chrono::seconds(IO_TIMEOUT_SEC));
+    co_await boost::beast::http::async_write_header(_stream, serializer, boost::asio::redirect_error(boost::asio::use_awaitable, _error));
+  }
+
+  boost::asio::awaitable<void> WriteChunk(boost::asio::const_buffer data) {
+    // 长度为0的块表示响应结束，不能写出
+    if (_error || data.size() == 0) {
+      co_return;
+    }
+    _stream.expires_after(std::chrono::seconds(IO_TIMEOUT_SEC));
+    if (_chunked) {
+      co_await boost::asio::async_write(_stream, boost::beast::http::make_chunk(data), boost::asio::redirect_error(boost::asio::use_awaitable, _error));
+    } else {
+      co_await boost::asio::async_write(_stream, data, boost::asio::redirect_error(boost::asio::use_awaitable, _error));
+    }
+  }
+
+  boost::asio::awaitable<void> EndChunked() {
+    if (_error || !_chunked) {
+      co_return;
+    }
+    _stream.expires_after(std::chrono::seconds(IO_TIMEOUT_SEC));
+    co_await boost::asio::async_write(_stream, boost::beast::http::make_chunk_last(), boost::asio::redirect_error(boost::asio::use_awaitable, _error));
+  }
+
+  // 回复后关闭连接，响应中带上Connection: close
+  void CloseAfterReply() {
+    _close_after = true;
+  }
+
+  [[nodiscard]] bool CloseAfter() const {
+    return _close_after || !KeepAlive();
+  }
+
+private:
+  [[nodiscard]] unsigned version() const {
+    return _parser.is_header_done() ? _parser.get().version() : 11;
+  }
+
+  [[nodiscard]] bool expects_continue() const {
+    return boost::beast::iequals(_parser.get()[boost::beast::http::field::expect], "100-continue");
+  }
+
+  // 已经给出最终响应时不再发送100 Continue；客户端还在等100 Continue时，它不会再发送请求体，
+  // 排空只会干等到超时，这种情况下回复后直接关闭连接
+  template <class Body>
+  void prepare_header(boost::beast::http::response<Body> &res) {
+    _responded = true;
+    if (!_continued && _parser.is_header_done() && !_parser.is_done() && expects_continue()) {
+      _close_after = true;
+    }
+    _continued = true;
+    res.set(boost::beast::http::field::server, "Beast demo");
+    res.keep_alive(!_close_after && KeepAlive());
+  }
+
+  boost::beast::tcp_stream &_stream;
+  boost::beast::flat_buffer &_buffer;
+  boost::beast::http::request_parser<boost::beast::http::buffer_body> &_parser;
+  boost::system::error_code _error;
+  bool _continued{false};
+  bool _responded{false};
+  bool _chunked{false};
+  bool _close_after{false};
+};
+
+using CoroHandler = std::function<boost::asio::awaitable<void>(HttpExchange &)>;
+using CoroRouter = Router<CoroHandler>;
+
+// 长连接上逐个处理请求: 只读请求头，请求体由处理函数按需分块读取
+boost::asio::awaitable<void> session(boost::asio::ip::tcp::socket sock, const CoroRouter &router) {
+  boost::beast::tcp_stream stream{std::move(sock)};
+  boost::beast::error_code errc;
+  stream.socket().set_option(boost::asio::ip::tcp::no_delay{true}, errc);
+  boost::beast::flat_buffer buffer;
+
+  for (;;) {
+    boost::beast::http::request_parser<boost::beast::http::buffer_body> parser;
+    parser.header_limit(HEADER_LIMIT);
+    parser.body_limit(BODY_LIMIT);
+
+    stream.expires_after(std::chrono::seconds(IO_TIMEOUT_SEC));
+    co_await boost::beast::http::async_read_header(stream, buffer, parser, boost::asio::redirect_error(boost::asio::use_awaitable, errc));
+    if (errc == boost::beast::http::error::end_of_stream) {
+      stream.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_send, errc);
+      co_return;
+    }
+
+    // 头部超限或Content-Length超过上限时请求体还没有读，回复后直接关闭连接
+    HttpExchange exchange{stream, buffer, parser};
+    if (errc == boost::beast::http::error::header_limit) {
+      exchange.CloseAfterReply();
+      co_await exchange.Reply(boost::beast::http::status::request_header_fields_too_large, "header too large");
+    } else if (errc == boost::beast::http::error::body_limit) {
+      exchange.CloseAfterReply();
+      co_await exchange.Reply(boost::beast::http::status::payload_too_large, "body too large");
+    } else if (!errc) {
+      auto match = router.Find(exchange.Header().method(), exchange.Path());
+      if (match._methods == nullptr) {
+        co_await exchange.Reply(boost::beast::http::status::not_found, "not found");
+      } else if (match._handler == nullptr) {
+        co_await exchange.Reply(boost::beast::http::status::bad_request, "invalid request-method");
+      } else {
+        co_await (*match._handler)(exchange);
+      }
+
+      // 分块编码的请求体边读边检查上限，此时处理函数可能还没有回复
+      if (exchange.Error() == boost::beast::http::error::body_limit && !exchange.Responded()) {
+        HttpExchange reply{stream, buffer, parser};
+        reply.CloseAfterReply();
+        co_await reply.Reply(boost::beast::http::status::payload_too_large, "body too large");
+      } else if (!exchange.CloseAfter()) {
+        co_await exchange.Drain();
+        if (!exchange.Error()) {
+          continue;
+        }
+      }
+    }
+
+    stream.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_send, errc);
+    co_return;
+  }
+}
+
+// 上传: 边读边计算长度和FNV-1a校验值，不保存请求体
+boost::asio::awaitable<void> handle_upload(HttpExchange &exchange) {
+  std::array<char, BODY_CHUNK_SIZE> chunk;
+  std::uint64_t total = 0;
+  std::uint32_t hash = 2166136261U;
+  while (std::size_t bytes = co_await exchange.ReadSome(boost::asio::buffer(chunk))) {
+    total += bytes;
+    for (std::size_t i = 0; i < bytes; ++i) {
+      hash = (hash ^ static_cast<unsigned char>(chunk[i])) * 16777619U;
+    }
+  }
+  if (exchange.Error()) {
+    co_return;
+  }
+  co_await exchange.Reply(boost::beast::http::status::ok, std::format("received {} bytes, fnv1a {:08x}\n", total, hash));
+}
+
+// 回显: 读到一块就以分块编码写回一块，请求和响应都不需要知道总长度
+boost::asio::awaitable<void> handle_echo(HttpExchange &exchange) {
+  std::array<char, BODY_CHUNK_SIZE> chunk;
+  // 先读第一块再写响应头，否则等待100 Continue的客户端不会发送请求体
+  std::size_t bytes = co_await exchange.ReadSome(boost::asio::buffer(chunk));
+  if (exchange.Error()) {
+    co_return;
+  }
+  auto content_type = exchange.Header()[boost::beast::http::field::content_type];
+  co_await exchange.BeginChunked(boost::beast::http::status::ok,
+                                 content_type.empty() ? "application/octet-stream" : std::string_view{content_type.data(), content_type.size()});
+  while (bytes > 0) {
+    co_await exchange.WriteChunk(boost::asio::buffer(chunk.data(), bytes));
+    bytes = co_await exchange.ReadSome(boost::asio::buffer(chunk));
+  }
+  co_await exchange.EndChunked();
+}
+
+// 静态文件: 小文件直接引用缓存，大文件按块读出后以分块编码写出
+boost::asio::awaitable<void> handle_file(HttpExchange &exchange, FileCache &files, std::string_view path) {
+  auto info = files.Stat(path);
+  if (!info) {
+    co_await exchange.Reply(boost::beast::http::status::not_found, "not found");
+    co_return;
+  }
+
+  const auto &header = exchange.Header();
+  if (auto iter = header.find(boost::beast::http::field::if_none_match);
+      iter != header.end() && etag_matches({iter->value().data(), iter->value().size()}, info->_etag)) {
+    boost::beast::http::response<boost::beast::http::empty_body> res{boost::beast::http::status::not_modified, header.version()};
+    res.set(boost::beast::http::field::etag, info->_etag);
+    co_await exchange.Write(std::move(res));
+    co_return;
+  }
+
+  if (auto data = files.Load(*info)) {
+    boost::beast::http::response<SharedBody> res{boost::beast::http::status::ok, header.version()};
+    res.set(boost::beast::http::field::content_type, std::string{info->_content_type});
+    res.set(boost::beast::http::field::etag, info->_etag);
+    res.body() = std::move(data);
+    co_await exchange.Write(std::move(res));
+    co_return;
+  }
+
+  std::ifstream file{info->_path, std::ios::binary};
+  if (!file.is_open()) {
+    co_await exchange.Reply(boost::beast::http::status::internal_server_error, "open failed");
+    co_return;
+  }
+  co_await exchange.BeginChunked(boost::beast::http::status::ok, info->_content_type);
+  std::array<char, BODY_CHUNK_SIZE> chunk;
+  while (!exchange.Error() && file.read(chunk.data(), chunk.size()).gcount() > 0) {
+    co_await exchange.WriteChunk(boost::asio::buffer(chunk.data(), static_cast<std::size_t>(file.gcount())));
+  }
+  co_await exchange.EndChunked();
+}
+
+void http_server(boost::asio::ip::tcp::acceptor &acceptor, IoPool &pool, const CoroRouter &router) {
+  auto on_accept = [&acceptor, &pool, &router](boost::beast::error_code errc, boost::asio::ip::tcp::socket sock) -> void {
+    if (!errc) {
+      auto executor = sock.get_executor();
+      boost::asio::co_spawn(executor, session(std::move(sock), router), boost::asio::detached);
+    }
+
+    http_server(acceptor, pool, router);
+  };
+#ifdef SO_REUSEPORT
+  acceptor.async_accept(std::move(on_accept));
+#else
+  acceptor.async_accept(pool.getIoContext(), std::move(on_accept));
+#endif
+}
+
+int main(int argc, char *argv[]) {
+  try {
+    FileCache files{argc > 1 ? argv[1] : "."};
+    const unsigned int threads = argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : std::thread::hardware_concurrency();
+
+    CoroRouter router;
+    router.Add(boost::beast::http::verb::post, "/upload", handle_upload);
+    router.Add(boost::beast::http::verb::post, "/echo", handle_echo);
+    router.Add(boost::beast::http::verb::get, "/index", [&files](HttpExchange &exchange) -> boost::asio::awaitable<void> {
+      return handle_file(exchange, files, "/index.html");
+    });
+    router.AddPrefix(boost::beast::http::verb::get, "/", [&files](HttpExchange &exchange) -> boost::asio::awaitable<void> {
+      return handle_file(exchange, files, exchange.Path());
+    });
+
+    IoPool pool{threads == 0 ? 1 : threads};
+    const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::tcp::v4(), 10088};
+    std::vector<boost::asio::ip::tcp::acceptor> acceptors;
+#ifdef SO_REUSEPORT
+    acceptors.reserve(pool.size());
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+      listen(acceptors.emplace_back(pool.getIoContext(i)), endpoint);
+    }
+#else
+    listen(acceptors.emplace_back(pool.getIoContext(0)), endpoint);
+#endif
+    for (auto &acceptor : acceptors) {
+      http_server(acceptor, pool, router);
+    }
+
+    pool.run();
+  } catch (const boost::system::system_error &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
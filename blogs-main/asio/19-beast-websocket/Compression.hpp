@@ -0,0 +1,216 @@
+#ifndef COMPRESSION_HPP
+#define COMPRESSION_HPP
+
+#include <boost/beast/core/rate_policy.hpp>
+#include <boost/beast/websocket/option.hpp>
+#include <boost/version.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <print>
+#include <string_view>
+#include <utility>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// permessage-deflate的默认配置，可以在命令行上用 key=value 覆盖
+// 每连接常驻的压缩+解压状态(见estimated_bytes_per_connection): 默认 window_bits=12、mem_level=4 约35KB，
+// window_bits=15 时约175KB，一万连接就是1.7GB；消息较大且重复度高、连接数少时再调大窗口
+#define DEFLATE_ENABLE true
+// LZ77窗口大小(9~15)，压缩状态的内存约为 2^(window_bits+2) 字节，是每连接内存的主要来源
+#define DEFLATE_WINDOW_BITS 12
+// 不保留上下文时每条消息独立压缩，压缩率下降，但消息之间不依赖历史窗口；Beast仍为每个连接常驻压缩状态，不能省内存
+#define DEFLATE_SERVER_NO_CONTEXT_TAKEOVER false
+#define DEFLATE_CLIENT_NO_CONTEXT_TAKEOVER false
+// 小于该字节数的消息不压缩，压缩小消息得不偿失
+#define DEFLATE_MIN_SIZE 64
+// zlib的内存级别(1~9)，压缩状态另需约 2^(mem_level+9) 字节
+#define DEFLATE_MEM_LEVEL 4
+#define DEFLATE_COMP_LEVEL 6
+
+struct DeflateConfig {
+  bool _enable{DEFLATE_ENABLE};
+  int _window_bits{DEFLATE_WINDOW_BITS};
+  bool _server_no_context_takeover{DEFLATE_SERVER_NO_CONTEXT_TAKEOVER};
+  bool _client_no_context_takeover{DEFLATE_CLIENT_NO_CONTEXT_TAKEOVER};
+  std::size_t _min_size{DEFLATE_MIN_SIZE};
+  int _mem_level{DEFLATE_MEM_LEVEL};
+  int _comp_level{DEFLATE_COMP_LEVEL};
+
+  /**
+    * @brief 解析形如 deflate=0、window_bits=12、server_no_context_takeover=1、min_size=256 的参数
+    * @return 不认识的参数返回false
+    **/
+  bool parse(std::string_view arg) {
+    auto eq = arg.find('=');
+    if (eq == std::string_view::npos) {
+      return false;
+    }
+    auto key = arg.substr(0, eq);
+    auto value = arg.substr(eq + 1);
+    long long number = 0;
+    std::from_chars(value.data(), value.data() + value.size(), number);
+
+    if (key == "deflate") {
+      _enable = number != 0;
+    } else if (key == "window_bits") {
+      _window_bits = static_cast<int>(std::clamp(number, 9LL, 15LL));
+    } else if (key == "server_no_context_takeover") {
+      _server_no_context_takeover = number != 0;
+    } else if (key == "client_no_context_takeover") {
+      _client_no_context_takeover = number != 0;
+    } else if (key == "min_size") {
+      _min_size = static_cast<std::size_t>(std::max(number, 0LL));
+    } else if (key == "mem_level") {
+      _mem_level = static_cast<int>(std::clamp(number, 1LL, 9LL));
+    } else if (key == "comp_level") {
+      _comp_level = static_cast<int>(std::clamp(number, 0LL, 9LL));
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  [[nodiscard]] boost::beast::websocket::permessage_deflate option() const {
+    boost::beast::websocket::permessage_deflate opt;
+    opt.server_enable = _enable;
+    opt.server_max_window_bits = _window_bits;
+    opt.client_max_window_bits = _window_bits;
+    opt.server_no_context_takeover = _server_no_context_takeover;
+    opt.client_no_context_takeover = _client_no_context_takeover;
+    opt.memLevel = _mem_level;
+    opt.compLevel = _comp_level;
+#if BOOST_VERSION >= 107900
+    opt.msg_size_threshold = _min_size;
+#endif
+    return opt;
+  }
+
+  // zlib文档给出的估算: 压缩 2^(wbits+2) + 2^(memLevel+9)，解压 2^wbits 再加约7KB
+  [[nodiscard]] std::size_t estimated_bytes_per_connection() const {
+    if (!_enable) {
+      return 0;
+    }
+    return (std::size_t{1} << (_window_bits + 2)) + (std::size_t{1} << (_mem_level + 9)) + (std::size_t{1} << _window_bits) + 7 * 1024;
+  }
+
+  void print() const {
+    std::print("permessage-deflate: {}, window_bits: {}, server_no_context_takeover: {}, client_no_context_takeover: {}, min_size: {}",
+               _enable, _window_bits, _server_no_context_takeover, _client_no_context_takeover, _min_size);
+#if BOOST_VERSION < 107900
+    std::print(" (ignored before Boost 1.79)");
+#endif
+    std::print(", ~{} KB per connection\n", estimated_bytes_per_connection() / 1024);
+  }
+};
+
+// 不限速，只记录socket上实际收发的字节数(含握手、帧头，压缩后的大小)，由basic_stream在每次读写完成时回调
+class CountingRatePolicy {
+  friend class boost::beast::rate_policy_access;
+
+public:
+  [[nodiscard]] std::uint64_t bytes_read() const noexcept {
+    return _read;
+  }
+
+  [[nodiscard]] std::uint64_t bytes_written() const noexcept {
+    return _written;
+  }
+
+private:
+  [[nodiscard]] std::size_t available_read_bytes() const noexcept {
+    return (std::numeric_limits<std::size_t>::max)();
+  }
+
+  [[nodiscard]] std::size_t available_write_bytes() const noexcept {
+    return (std::numeric_limits<std::size_t>::max)();
+  }
+
+  void transfer_read_bytes(std::size_t bytes) noexcept {
+    _read += bytes;
+  }
+
+  void transfer_write_bytes(std::size_t bytes) noexcept {
+    _written += bytes;
+  }
+
+  void on_timer() const noexcept {}
+
+  std::uint64_t _read{0};
+  std::uint64_t _written{0};
+};
+
+/**
+  * @brief 压缩效果统计: 应用层消息字节数与TCP层实际收发字节数之比，以及每KB应用层消息对应的进程CPU时间
+  * @details 线上字节数来自各连接的CountingRatePolicy，连接关闭时累加到这里，在线连接在统计时逐个分片采样。
+  *          压缩在Beast的读写内部完成，无法单独计时，CPU时间取整个进程的(含握手、收发、业务逻辑)，
+  *          压缩本身的开销需要在同样负载下对比 deflate=0 与 deflate=1 两次运行的差值
+  **/
+struct CompressionMetrics {
+  std::atomic<std::uint64_t> _payload_out{0};
+  std::atomic<std::uint64_t> _payload_in{0};
+  std::atomic<std::uint64_t> _closed_wire_out{0};
+  std::atomic<std::uint64_t> _closed_wire_in{0};
+
+  static CompressionMetrics &getInstance() {
+    static CompressionMetrics instance;
+    return instance;
+  }
+
+  void on_close(std::uint64_t out, std::uint64_t in) {
+    _closed_wire_out.fetch_add(out, std::memory_order_relaxed);
+    _closed_wire_in.fetch_add(in, std::memory_order_relaxed);
+  }
+
+  /**
+    * @brief 打印本周期的统计
+    * @param live_wire_out/live_wire_in 在线连接采样得到的线上字节数
+    **/
+  void report(std::uint64_t live_wire_out, std::uint64_t live_wire_in) {
+    const std::uint64_t payload_out = _payload_out.load(std::memory_order_relaxed);
+    const std::uint64_t payload_in = _payload_in.load(std::memory_order_relaxed);
+    const std::uint64_t wire_out = _closed_wire_out.load(std::memory_order_relaxed) + live_wire_out;
+    const std::uint64_t wire_in = _closed_wire_in.load(std::memory_order_relaxed) + live_wire_in;
+    const double cpu_us = process_cpu_us();
+
+    const double delta_kb = static_cast<double>(payload_out + payload_in - _last_payload) / 1024.0;
+    const double process_cpu_per_kb = delta_kb > 0 ? (cpu_us - _last_cpu_us) / delta_kb : 0.0;
+    _last_payload = payload_out + payload_in;
+    _last_cpu_us = cpu_us;
+
+    auto ratio = [](std::uint64_t wire, std::uint64_t payload) -> double {
+      return payload == 0 ? 0.0 : static_cast<double>(wire) / static_cast<double>(payload);
+    };
+    std::print("payload out/in: {}/{} B, wire out/in: {}/{} B, ratio out/in: {:.3f}/{:.3f}, process cpu per payload KB: {:.2f} us\n",
+               payload_out, payload_in, wire_out, wire_in, ratio(wire_out, payload_out), ratio(wire_in, payload_in), process_cpu_per_kb);
+  }
+
+private:
+  static double process_cpu_us() {
+#ifndef _WIN32
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    auto to_us = [](const timeval &tv) -> double {
+      return static_cast<double>(tv.tv_sec) * 1e6 + static_cast<double>(tv.tv_usec);
+    };
+    return to_us(usage.ru_utime) + to_us(usage.ru_stime);
+#else
+    return 0.0;
+#endif
+  }
+
+  // 只由统计定时器所在的线程访问
+  std::uint64_t _last_payload{0};
+  double _last_cpu_us{0.0};
+};
+
+#define compressionMetrics CompressionMetrics::getInstance()
+
+#endif // COMPRESSION_HPP
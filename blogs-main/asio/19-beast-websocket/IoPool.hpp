@@ -0,0 +1,68 @@
+#ifndef IOPOOL_HPP
+#define IOPOOL_HPP
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// WebSocket连接的分片线程: 第i个io_context就是ConnectionMgr的第i个分片，
+// 连接建立时按分片号选定io_context，之后读写、进出房间和广播入队都在这个线程上完成
+class IoPool {
+public:
+  explicit IoPool(unsigned int size) : _ioContexts(size) {
+    _workGuards.reserve(size);
+    for (auto &io_context : _ioContexts) {
+      _workGuards.emplace_back(boost::asio::make_work_guard(io_context));
+    }
+  }
+
+  // 阻塞直到stop()被调用，各分片线程都退出后返回，之后才能清理ConnectionMgr
+  void run() {
+    _threads.reserve(_ioContexts.size());
+    for (auto &io_context : _ioContexts) {
+      _threads.emplace_back([&io_context]() -> void {
+        io_context.run();
+      });
+    }
+    _threads.clear();
+  }
+
+  // 由信号处理在0号分片线程上调用，尚未发出的广播随io_context一起丢弃
+  void stop() {
+    for (auto &io_context : _ioContexts) {
+      io_context.stop();
+    }
+  }
+
+  // 分片号到io_context，取模后即使分片号越界也落在某个线程上
+  boost::asio::io_context &getIoContext(std::size_t index) {
+    return _ioContexts[index % _ioContexts.size()];
+  }
+
+  [[nodiscard]] std::size_t size() const {
+    return _ioContexts.size();
+  }
+
+private:
+  std::vector<boost::asio::io_context> _ioContexts;
+  std::vector<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> _workGuards;
+  std::vector<std::jthread> _threads;
+};
+
+// 打开监听socket；支持SO_REUSEPORT时每个分片各开一个，由内核把握手完成的连接直接分到分片线程，
+// 升级为WebSocket的突发连接较多，backlog取系统上限
+inline void listen(boost::asio::ip::tcp::acceptor& acceptor, const boost::asio::ip::tcp::endpoint& endpoint) {
+  acceptor.open(endpoint.protocol());
+  acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+#ifdef SO_REUSEPORT
+  acceptor.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
+#endif
+  acceptor.bind(endpoint);
+  acceptor.listen(boost::asio::socket_base::max_listen_connections);
+}
+
+#endif // IOPOOL_HPP
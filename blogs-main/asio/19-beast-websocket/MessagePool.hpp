@@ -0,0 +1,119 @@
+#ifndef MESSAGEPOOL_HPP
+#define MESSAGEPOOL_HPP
+
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 每个线程最多缓存的空闲消息数
+#define MESSAGE_POOL_MAX_FREE 1024
+// 容量超过该值的消息用完直接释放，不回池，避免偶尔的大消息长期占着内存
+#define MESSAGE_POOL_MAX_CAPACITY 1024 * 64
+
+/**
+  * @brief 线程本地的对象空闲链表，取还都不加锁
+  * @details 在一个线程取出、在另一个线程归还的对象进入归还线程的链表，每个链表都有上限，超出的直接释放
+  **/
+template <typename T, std::size_t MaxFree>
+class ThreadLocalPool {
+public:
+  static T *acquire() {
+    auto &free = instance()._free;
+    if (free.empty()) {
+      return new T();
+    }
+    T *obj = free.back();
+    free.pop_back();
+    return obj;
+  }
+
+  static void release(T *obj) {
+    auto &free = instance()._free;
+    if (free.size() < MaxFree) {
+      free.push_back(obj);
+    } else {
+      delete obj;
+    }
+  }
+
+private:
+  ThreadLocalPool() {
+    _free.reserve(MaxFree);
+  }
+
+  ~ThreadLocalPool() {
+    for (T *obj : _free) {
+      delete obj;
+    }
+  }
+
+  static ThreadLocalPool &instance() {
+    thread_local ThreadLocalPool pool;
+    return pool;
+  }
+
+  std::vector<T *> _free;
+};
+
+/**
+  * @brief 待发送的消息，侵入式引用计数，广播时所有连接共享同一个对象
+  * @details 最后一个引用释放时清空内容回到线程本地的池中，字符串的容量保留，下次取出时写入不再分配；
+  *          放入发送队列之后视为只读
+  **/
+class Message {
+public:
+  static boost::intrusive_ptr<Message> acquire() {
+    return boost::intrusive_ptr<Message>{ThreadLocalPool<Message, MESSAGE_POOL_MAX_FREE>::acquire()};
+  }
+
+  static boost::intrusive_ptr<Message> make(std::string_view data) {
+    auto msg = acquire();
+    msg->_data.assign(data);
+    return msg;
+  }
+
+  std::string &data() {
+    return _data;
+  }
+
+  [[nodiscard]] const std::string &data() const {
+    return _data;
+  }
+
+  [[nodiscard]] std::size_t size() const {
+    return _data.size();
+  }
+
+private:
+  friend class ThreadLocalPool<Message, MESSAGE_POOL_MAX_FREE>;
+  Message() = default;
+  ~Message() = default;
+
+  friend void intrusive_ptr_add_ref(Message *msg) {
+    msg->_refs.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  friend void intrusive_ptr_release(Message *msg) {
+    if (msg->_refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+    if (msg->_data.capacity() > MESSAGE_POOL_MAX_CAPACITY) {
+      delete msg;
+      return;
+    }
+    msg->_data.clear();
+    ThreadLocalPool<Message, MESSAGE_POOL_MAX_FREE>::release(msg);
+  }
+
+  std::atomic<std::uint32_t> _refs{0};
+  std::string _data;
+};
+
+using MessagePtr = boost::intrusive_ptr<Message>;
+
+#endif // MESSAGEPOOL_HPP
@@ -0,0 +1,84 @@
+#ifndef SENDQUEUE_HPP
+#define SENDQUEUE_HPP
+
+#include "MessagePool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// 每个线程最多缓存的空闲队列节点数
+#define SEND_QUEUE_NODE_POOL_MAX_FREE 4096
+
+/**
+  * @brief 多生产者单消费者的发送队列，入队无锁
+  * @details 生产者用CAS把节点压到栈顶；消费者(连接的写协程)一次取走整条链并反转回入队顺序，
+  *          取一次就是一批，不需要逐条出队。排队的字节数单独计数，供上层做背压；节点从线程本地的池中取还
+  **/
+class SendQueue {
+public:
+  SendQueue() = default;
+  SendQueue(const SendQueue &) = delete;
+  SendQueue &operator=(const SendQueue &) = delete;
+
+  ~SendQueue() {
+    Node *node = _head.exchange(nullptr, std::memory_order_acquire);
+    while (node != nullptr) {
+      recycle(std::exchange(node, node->_next));
+    }
+  }
+
+  // 返回入队前已排队的字节数；入队与empty()都是seq_cst，配合上层写标记的seq_cst读写，保证入队方与消费者至少有一方看到对方
+  std::size_t push(MessagePtr data) {
+    const std::size_t size = data->size();
+    auto *node = NodePool::acquire();
+    node->_data = std::move(data);
+    node->_next = _head.load(std::memory_order_relaxed);
+    while (!_head.compare_exchange_weak(node->_next, node, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    }
+    return _bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+
+  // 只能由消费者调用，按入队顺序追加到batch
+  void takeAll(std::vector<MessagePtr> &batch) {
+    Node *node = _head.exchange(nullptr, std::memory_order_acquire);
+    const std::size_t begin = batch.size();
+    while (node != nullptr) {
+      batch.push_back(std::move(node->_data));
+      recycle(std::exchange(node, node->_next));
+    }
+    std::reverse(batch.begin() + static_cast<std::ptrdiff_t>(begin), batch.end());
+  }
+
+  [[nodiscard]] bool empty() const {
+    return _head.load(std::memory_order_seq_cst) == nullptr;
+  }
+
+  // 消息写出后扣减，返回剩余排队字节数
+  std::size_t release(std::size_t size) {
+    return _bytes.fetch_sub(size, std::memory_order_relaxed) - size;
+  }
+
+  [[nodiscard]] std::size_t bytes() const {
+    return _bytes.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Node {
+    MessagePtr _data;
+    Node *_next{nullptr};
+  };
+  using NodePool = ThreadLocalPool<Node, SEND_QUEUE_NODE_POOL_MAX_FREE>;
+
+  static void recycle(Node *node) {
+    node->_data.reset();
+    NodePool::release(node);
+  }
+
+  std::atomic<Node *> _head{nullptr};
+  std::atomic<std::size_t> _bytes{0};
+};
+
+#endif // SENDQUEUE_HPP
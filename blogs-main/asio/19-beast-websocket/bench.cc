@@ -0,0 +1,217 @@
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/websocket/stream.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// 广播扇出延迟: subscribers个连接加入同一房间，另一个连接逐轮发送带时间戳的消息，
+// 统计每条消息从发出到各订阅者收到的延迟，以及最后一个订阅者收到的时间(整轮扇出耗时)
+// 用法: bench [订阅者数] [轮数] [线程数] [消息附带的JSON字节数] [deflate: 0|1]
+
+using Clock = std::chrono::steady_clock;
+using WsStream = boost::beast::websocket::stream<boost::asio::ip::tcp::socket>;
+
+const boost::asio::ip::tcp::endpoint server_endpoint{boost::asio::ip::make_address("127.0.0.1"), 10088};
+
+bool offer_deflate = false;
+std::atomic<int> ready{0};
+std::atomic<std::int64_t> received{0};
+std::vector<double> latencies_us;
+// 每轮最后一个订阅者收到消息的时刻
+std::vector<std::atomic<std::int64_t>> last_delivery_ns;
+
+std::int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+class Subscriber : public std::enable_shared_from_this<Subscriber> {
+public:
+  Subscriber(boost::asio::io_context &ioc, std::vector<double> &latencies) : _ws(ioc), _latencies(latencies) {
+    offer(_ws);
+  }
+
+  static void offer(WsStream &ws) {
+    boost::beast::websocket::permessage_deflate opt;
+    opt.client_enable = offer_deflate;
+    ws.set_option(opt);
+  }
+
+  void start() {
+    _ws.next_layer().async_connect(server_endpoint, [self = shared_from_this()](boost::beast::error_code errc) -> void {
+      if (errc) {
+        std::print("connect error: {}\n", errc.message());
+        return;
+      }
+      self->_ws.async_handshake("127.0.0.1", "/", [self](boost::beast::error_code errc) -> void {
+        if (errc) {
+          std::print("handshake error: {}\n", errc.message());
+          return;
+        }
+        // 同一连接上的消息按序处理，收到ping的回显说明加入房间已经生效
+        self->_ws.async_write(boost::asio::buffer(std::string_view{"/join bench"}), [self](boost::beast::error_code errc, std::size_t) -> void {
+          if (errc) {
+            return;
+          }
+          self->_ws.async_write(boost::asio::buffer(std::string_view{"ping"}), [self](boost::beast::error_code, std::size_t) -> void {});
+          self->read();
+        });
+      });
+    });
+  }
+
+  WsStream::executor_type get_executor() {
+    return _ws.get_executor();
+  }
+
+  void close() {
+    boost::beast::error_code errc;
+    _ws.next_layer().close(errc);
+  }
+
+private:
+  void read() {
+    _ws.async_read(_buffer, [self = shared_from_this()](boost::beast::error_code errc, std::size_t) -> void {
+      if (errc) {
+        return;
+      }
+      self->on_message(boost::beast::buffers_to_string(self->_buffer.data()));
+      self->_buffer.clear();
+      self->read();
+    });
+  }
+
+  // 广播内容为"轮次 发送时刻 [填充]"
+  void on_message(const std::string &message) {
+    if (message.starts_with("Echo:")) {
+      ready.fetch_add(1);
+      return;
+    }
+    auto space = message.find(' ');
+    std::size_t round = 0;
+    std::int64_t sent = 0;
+    std::from_chars(message.data(), message.data() + space, round);
+    std::from_chars(message.data() + space + 1, message.data() + message.size(), sent);
+
+    const std::int64_t now = now_ns();
+    _latencies.push_back(static_cast<double>(now - sent) / 1000.0);
+    auto &last = last_delivery_ns[round];
+    std::int64_t prev = last.load();
+    while (prev < now && !last.compare_exchange_weak(prev, now)) {
+    }
+    received.fetch_add(1);
+  }
+
+  WsStream _ws;
+  boost::beast::flat_buffer _buffer;
+  std::vector<double> &_latencies;
+};
+
+void raise_fd_limit() {
+#ifndef _WIN32
+  rlimit limit{};
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+#endif
+}
+
+// 模拟聊天业务的JSON消息体
+std::string make_filler(std::size_t bytes) {
+  std::string filler;
+  for (int id = 0; filler.size() < bytes; ++id) {
+    filler += R"({"id":)" + std::to_string(id) + R"(,"user":"alice","room":"bench","text":"hello from the benchmark"},)";
+  }
+  filler.resize(bytes);
+  return filler;
+}
+
+double percentile(const std::vector<double> &sorted, double pct) {
+  return sorted.empty() ? 0.0 : sorted[static_cast<std::size_t>(pct * static_cast<double>(sorted.size() - 1))];
+}
+
+int main(int argc, char *argv[]) {
+  const int subscribers = argc > 1 ? std::atoi(argv[1]) : 10000;
+  const int rounds = argc > 2 ? std::atoi(argv[2]) : 50;
+  const int thread_count = std::max(1, argc > 3 ? std::atoi(argv[3]) : 4);
+  const std::string filler = make_filler(argc > 4 ? static_cast<std::size_t>(std::atoi(argv[4])) : 0);
+  offer_deflate = argc > 5 && std::atoi(argv[5]) != 0;
+  raise_fd_limit();
+  last_delivery_ns = std::vector<std::atomic<std::int64_t>>(static_cast<std::size_t>(rounds));
+
+  std::vector<std::unique_ptr<boost::asio::io_context>> contexts;
+  std::vector<std::vector<double>> thread_latencies(static_cast<std::size_t>(thread_count));
+  std::vector<std::shared_ptr<Subscriber>> subs;
+  for (int i = 0; i < thread_count; ++i) {
+    contexts.emplace_back(std::make_unique<boost::asio::io_context>());
+  }
+  for (int i = 0; i < subscribers; ++i) {
+    auto index = static_cast<std::size_t>(i % thread_count);
+    subs.emplace_back(std::make_shared<Subscriber>(*contexts[index], thread_latencies[index]))->start();
+  }
+
+  std::vector<std::jthread> threads;
+  for (auto &ioc : contexts) {
+    threads.emplace_back([&ioc]() -> void { ioc->run(); });
+  }
+
+  auto deadline = Clock::now() + std::chrono::seconds(60);
+  while (ready.load() < subscribers && Clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::print("{} / {} subscribers joined\n", ready.load(), subscribers);
+
+  boost::asio::io_context pub_ioc;
+  WsStream publisher{pub_ioc};
+  Subscriber::offer(publisher);
+  publisher.next_layer().connect(server_endpoint);
+  publisher.next_layer().set_option(boost::asio::ip::tcp::no_delay{true});
+  publisher.handshake("127.0.0.1", "/");
+
+  std::vector<double> fanout_us;
+  for (int round = 0; round < rounds; ++round) {
+    const std::int64_t sent = now_ns();
+    publisher.write(boost::asio::buffer("/say bench " + std::to_string(round) + " " + std::to_string(sent) + " " + filler));
+
+    const std::int64_t expected = static_cast<std::int64_t>(ready.load()) * (round + 1);
+    auto round_deadline = Clock::now() + std::chrono::seconds(10);
+    while (received.load() < expected && Clock::now() < round_deadline) {
+      std::this_thread::yield();
+    }
+    fanout_us.push_back(static_cast<double>(last_delivery_ns[static_cast<std::size_t>(round)].load() - sent) / 1000.0);
+  }
+
+  boost::beast::error_code errc;
+  publisher.next_layer().close(errc);
+  for (auto &sub : subs) {
+    boost::asio::post(sub->get_executor(), [sub]() -> void { sub->close(); });
+  }
+  threads.clear();
+
+  for (auto &local : thread_latencies) {
+    latencies_us.insert(latencies_us.end(), local.begin(), local.end());
+  }
+  std::sort(latencies_us.begin(), latencies_us.end());
+  std::sort(fanout_us.begin(), fanout_us.end());
+  std::print("delivered {} / {}\n", latencies_us.size(), static_cast<std::int64_t>(ready.load()) * rounds);
+  std::print("per-subscriber latency p50: {:.0f} us, p99: {:.0f} us\n", percentile(latencies_us, 0.50), percentile(latencies_us, 0.99));
+  std::print("full fan-out p50: {:.0f} us, p99: {:.0f} us\n", percentile(fanout_us, 0.50), percentile(fanout_us, 0.99));
+}
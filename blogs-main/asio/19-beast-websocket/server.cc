@@ -2,7 +2,6 @@
 #include <boost/asio/ip/address_v4.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core.hpp>
-#include <boost/beast/core/buffers_to_string.hpp>
 #include <boost/beast/core/error.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/core/stream_traits.hpp>
@@ -18,37 +17,115 @@
 #include <boost/asio/detached.hpp>
 #include <boost/asio/signal_set.hpp>
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include "Compression.hpp"
+#include "IoPool.hpp"
+#include "MessagePool.hpp"
+#include "SendQueue.hpp"
+
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <memory>
-#include <mutex>
 #include <print>
-#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// 定期打印在线连接数和压缩统计的间隔
+#define STATS_INTERVAL_SEC 10
+// 每个连接排队待发送的字节上限，超过说明对端读得太慢，断开它而不是无限堆积
+#define SEND_QUEUE_MAX_BYTES 1024 * 256
+// 排队超过该值时暂停读取该连接的请求，降到一半以下再恢复
+#define SEND_QUEUE_PAUSE_BYTES SEND_QUEUE_MAX_BYTES / 2
+// 单条入站消息的字节上限
+#define READ_MESSAGE_MAX 1024 * 1024
+// 接收缓冲区常驻的容量，读到大消息后超出的部分在处理完后释放
+#define RECV_BUFFER_KEEP_BYTES 1024 * 16
+
+// tcp_stream换成计数的限速策略，用于统计压缩后实际收发的字节数
+using WsStream = boost::beast::websocket::stream<
+  boost::beast::basic_stream<boost::asio::ip::tcp, boost::asio::any_io_executor, CountingRatePolicy>>;
 
 class Connection;
+/**
+  * @brief 连接管理按io_context分片，每个分片只在所属线程上访问，连接和断开都不需要加锁
+  * @details 连接的回调都运行在接受它的那个io_context上，因此增删总是落在本线程的分片；
+  *          其他线程需要访问某个分片时，post到该分片的io_context上执行
+  **/
 class ConnectionMgr {
 public:
   static ConnectionMgr &getInstance();
+  void init(IoPool &pool);
   void addConnection(std::shared_ptr<Connection> conn);
-  void removeConnection(const std::string &uuid);
+  void removeConnection(std::size_t shard, const std::string &uuid);
+
+  // 以下两个只能在连接所属的线程上调用
+  void joinRoom(const std::shared_ptr<Connection> &conn, const std::string &room);
+  void leaveRoom(const std::shared_ptr<Connection> &conn, const std::string &room);
+
+  /**
+    * @brief 向房间内所有连接广播同一条消息，可以在任意线程调用
+    * @details 消息只构造一次，所有订阅者共享同一块不可变内存；每个分片只post一次，在分片所属线程上逐个入队
+    **/
+  void broadcast(const std::string &room, MessagePtr message);
+  // 所有io_context停止后调用，连接先于io_context析构
+  void clear();
+
+  // 各分片计数之和，只用于统计，不要求精确
+  [[nodiscard]] std::size_t size() const;
+
+  // 在各分片线程上采样在线连接的TCP收发字节数，结果在下一次统计时读取
+  void sampleWireBytes();
+  [[nodiscard]] std::pair<std::uint64_t, std::uint64_t> wireBytes() const;
 
 private:
   ConnectionMgr() = default;
   ~ConnectionMgr() = default;
 
-  std::mutex _mtx;
-  std::unordered_map<std::string, std::shared_ptr<Connection>> _connections;
+  // 按缓存行对齐，避免相邻分片的计数互相伪共享
+  struct alignas(64) Shard {
+    std::unordered_map<std::string, std::shared_ptr<Connection>> _connections;
+    std::unordered_map<std::string, std::unordered_set<std::shared_ptr<Connection>>> _rooms;
+    std::atomic<std::size_t> _count{0};
+    std::atomic<std::uint64_t> _wire_out{0};
+    std::atomic<std::uint64_t> _wire_in{0};
+  };
+
+  IoPool *_pool{nullptr};
+  std::unique_ptr<Shard[]> _shards;
+  std::size_t _shard_count{0};
 };
 
 class Connection : public std::enable_shared_from_this<Connection> {
 public:
-  Connection(boost::asio::io_context &ioc)
-    : _ioc(ioc), _strand(boost::asio::make_strand(_ioc)), _ws_ptr(std::make_unique<boost::beast::websocket::stream<boost::beast::tcp_stream>>(_strand)) {
-    boost::uuids::uuid uuid = boost::uuids::random_generator_mt19937()();
-    _uuid = boost::uuids::to_string(uuid);
+  Connection(boost::asio::io_context &ioc, std::size_t shard)
+    : _shard(shard), _ioc(ioc), _strand(boost::asio::make_strand(_ioc)), _ws_ptr(std::make_unique<WsStream>(_strand)) {
+    // 生成器的状态较大，每个线程只初始化一次，大量建连时不再反复播种
+    thread_local boost::uuids::random_generator_mt19937 generator;
+    _uuid = boost::uuids::to_string(generator());
   }
 
-  void asyncAccept() {
+  void asyncAccept(const boost::beast::websocket::permessage_deflate &deflate) {
+    // 握手和空闲超时交给beast管理，掉线的客户端不会一直占着连接
+    _ws_ptr->set_option(boost::beast::websocket::stream_base::timeout::suggested(boost::beast::role_type::server));
+    _ws_ptr->set_option(deflate);
+    // 每条消息作为一个完整的帧写出，不再按写缓冲大小切分
+    _ws_ptr->auto_fragment(false);
+    _ws_ptr->read_message_max(READ_MESSAGE_MAX);
     _ws_ptr->async_accept(
       [self = shared_from_this()](boost::beast::error_code errc) -> void {
         if (!errc) {
@@ -65,76 +142,175 @@ public:
       [self = shared_from_this()](boost::beast::error_code errc, std::size_t bytes_transferred) -> void {
         if (!errc) {
           self->_ws_ptr->text(self->_ws_ptr->got_text());
-          std::string message(boost::beast::buffers_to_string(self->_recv_buffer.data()));
-          self->_recv_buffer.consume(bytes_transferred);
+          compressionMetrics._payload_in.fetch_add(bytes_transferred, std::memory_order_relaxed);
 
-          std::print("received message: {}\n", message);
-          self->asyncSend("Echo: " + message);
+          // flat_buffer的数据是连续的，直接以视图交给处理函数，处理完再消费
+          auto data = self->_recv_buffer.cdata();
+          self->handleMessage({static_cast<const char *>(data.data()), data.size()});
+          self->_recv_buffer.consume(bytes_transferred);
+          if (self->_recv_buffer.capacity() > RECV_BUFFER_KEEP_BYTES) {
+            self->_recv_buffer.shrink_to_fit();
+          }
+          // 回复堆积时先不读下一条，由写协程在队列降下来后恢复
+          if (self->_send_queue.bytes() >= SEND_QUEUE_PAUSE_BYTES) {
+            self->_read_paused = true;
+            return;
+          }
           self->start();
         } else {
           std::print("read error, error is: {}\n", errc.message());
-          ConnectionMgr::getInstance().removeConnection(self->getUuid());
+          ConnectionMgr::getInstance().removeConnection(self->getShard(), self->getUuid());
         }
       }
     );
   }
 
-  void asyncSend(std::string data) {
-    int size;
-    {
-      std::lock_guard<std::mutex> lock(_send_mtx);
-      size = _send_queue.size();
-      _send_queue.push(std::move(data));
-    }
+  /**
+    * @brief 简单的文本协议: "/join 房间"、"/leave 房间"、"/say 房间 内容"，其余消息原样回显
+    * @param message 指向接收缓冲区的视图，只在本次调用内有效，需要保留的内容要自行拷贝
+    **/
+  void handleMessage(std::string_view message) {
+    auto command = message.substr(0, message.find(' '));
+    auto args = command.size() < message.size() ? message.substr(command.size() + 1) : std::string_view{};
 
-    if (size >= 1) {
-      return;
+    if (command == "/join" && !args.empty()) {
+      ConnectionMgr::getInstance().joinRoom(shared_from_this(), std::string{args});
+    } else if (command == "/leave" && !args.empty()) {
+      ConnectionMgr::getInstance().leaveRoom(shared_from_this(), std::string{args});
+    } else if (command == "/say" && args.find(' ') != std::string_view::npos) {
+      auto room = args.substr(0, args.find(' '));
+      ConnectionMgr::getInstance().broadcast(std::string{room}, Message::make(args.substr(room.size() + 1)));
+    } else {
+      std::print("received message: {}\n", message);
+      // 回复从池中取，字符串容量复用，稳定后不再分配
+      auto reply = Message::acquire();
+      reply->data().append("Echo: ").append(message);
+      asyncSend(std::move(reply));
     }
+  }
 
-    boost::asio::co_spawn(
-      _strand,
-      [self = shared_from_this()]() -> boost::asio::awaitable<void> {
-        while (true) {
-          std::string data;
-          {
-            std::lock_guard<std::mutex> lock(self->_send_mtx);
-            if (self->_send_queue.empty()) {
-              break;
-            }
-            data = std::move(self->_send_queue.front());
-            self->_send_queue.pop();
-          }
+  /**
+    * @brief 可以在任意线程调用，入队无锁；广播时所有连接的队列里放的是同一个消息对象，写出时直接引用
+    * @return 连接已关闭或排队超过上限时返回false，后者会断开连接
+    **/
+  bool asyncSend(MessagePtr data) {
+    if (_closed.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    if (_send_queue.bytes() >= SEND_QUEUE_MAX_BYTES) {
+      std::print("send queue overflow, closing slow connection {}\n", _uuid);
+      close();
+      return false;
+    }
 
-          try {
-            co_await self->_ws_ptr->async_write(boost::asio::buffer(data), boost::asio::use_awaitable);
-          } catch (boost::beast::system_error &e) {
-            std::print("write error, error is: {}\n", e.what());
-            ConnectionMgr::getInstance().removeConnection(self->getUuid());
-            break;
-          }
-        }
+    _send_queue.push(std::move(data));
+    if (!_writing.exchange(true, std::memory_order_seq_cst)) {
+      boost::asio::co_spawn(_strand, [self = shared_from_this()]() -> boost::asio::awaitable<void> {
+        co_await self->writer();
       }, boost::asio::detached);
+    }
+    return true;
+  }
+
+  // 在strand上关闭socket，挂起的读操作随之失败，由读回调移除连接
+  void close() {
+    if (_closed.exchange(true, std::memory_order_relaxed)) {
+      return;
+    }
+    boost::asio::post(_strand, [self = shared_from_this()]() -> void {
+      boost::beast::get_lowest_layer(*self->_ws_ptr).close();
+    });
   }
 
   std::string &getUuid() {
     return this->_uuid;
   }
 
+  [[nodiscard]] std::size_t getShard() const {
+    return _shard;
+  }
+
+  // 已加入的房间，只在所属线程上访问，断开时据此退出所有房间
+  std::vector<std::string> &getRooms() {
+    return _rooms;
+  }
+
   boost::asio::ip::tcp::socket &getSocket() {
     return boost::beast::get_lowest_layer(*_ws_ptr).socket();
   }
 
+  // 只能在所属线程上调用
+  std::pair<std::uint64_t, std::uint64_t> wireBytes() {
+    const auto &policy = boost::beast::get_lowest_layer(*_ws_ptr).rate_policy();
+    return {policy.bytes_written(), policy.bytes_read()};
+  }
+
 private:
+  /**
+    * @brief 写协程，只在strand上运行且同一时刻至多一个
+    * @details 每次取走队列中的全部消息作为一批连续写出，一批多于一条时用TCP_CORK让内核把小帧合并成整段再发
+    **/
+  boost::asio::awaitable<void> writer() {
+    for (;;) {
+      _batch.clear();
+      _send_queue.takeAll(_batch);
+      if (_batch.empty()) {
+        // 清除标记前入队的消息，入队方看到标记为true不会启动写协程，这里需要再检查一次；
+        // 这是"先写自己的、再读对方的"两方握手，release/acquire允许这里的写和读重排，两边都必须用seq_cst
+        _writing.store(false, std::memory_order_seq_cst);
+        if (_send_queue.empty() || _writing.exchange(true, std::memory_order_seq_cst)) {
+          co_return;
+        }
+        continue;
+      }
+
+      cork(_batch.size() > 1);
+      for (const auto &data : _batch) {
+        boost::beast::error_code errc;
+        co_await _ws_ptr->async_write(boost::asio::buffer(data->data()), boost::asio::redirect_error(boost::asio::use_awaitable, errc));
+        if (errc) {
+          // 保持_writing为true，之后不再启动写协程，剩余消息随连接析构释放
+          std::print("write error, error is: {}\n", errc.message());
+          _closed.store(true, std::memory_order_relaxed);
+          ConnectionMgr::getInstance().removeConnection(getShard(), getUuid());
+          co_return;
+        }
+        compressionMetrics._payload_out.fetch_add(data->size(), std::memory_order_relaxed);
+        if (_send_queue.release(data->size()) < SEND_QUEUE_PAUSE_BYTES / 2 && _read_paused) {
+          _read_paused = false;
+          start();
+        }
+      }
+      cork(false);
+    }
+  }
+
+  void cork(bool enable) {
+#ifdef TCP_CORK
+    boost::beast::error_code errc;
+    getSocket().set_option(boost::asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_CORK>(enable), errc);
+#else
+    static_cast<void>(enable);
+#endif
+  }
+
   std::string _uuid;
+  std::size_t _shard;
   boost::asio::io_context &_ioc;
   boost::asio::strand<boost::asio::io_context::executor_type> _strand;
 
-  std::unique_ptr<boost::beast::websocket::stream<boost::beast::tcp_stream>> _ws_ptr;
+  std::unique_ptr<WsStream> _ws_ptr;
 
   boost::beast::flat_buffer _recv_buffer;
 
-  std::queue<std::string> _send_queue;
-  std::mutex _send_mtx;
+  SendQueue _send_queue;
+  std::atomic<bool> _writing{false};
+  std::atomic<bool> _closed{false};
+  // 以下只在strand上访问
+  std::vector<MessagePtr> _batch;
+  bool _read_paused{false};
+
+  std::vector<std::string> _rooms;
 };
 
 ConnectionMgr &ConnectionMgr::getInstance() {
@@ -142,63 +318,220 @@ ConnectionMgr &ConnectionMgr::getInstance() {
   return instance;
 }
 
+void ConnectionMgr::init(IoPool &pool) {
+  _pool = &pool;
+  _shard_count = pool.size();
+  _shards = std::make_unique<Shard[]>(_shard_count);
+}
+
 void ConnectionMgr::addConnection(std::shared_ptr<Connection> conn) {
-  std::lock_guard<std::mutex> lock(_mtx);
-  _connections[conn->getUuid()] = conn;
+  auto &shard = _shards[conn->getShard()];
+  shard._connections[conn->getUuid()] = std::move(conn);
+  shard._count.store(shard._connections.size(), std::memory_order_relaxed);
 }
 
-void ConnectionMgr::removeConnection(const std::string &uuid) {
-  std::lock_guard<std::mutex> lock(_mtx);
-  _connections.erase(uuid);
+void ConnectionMgr::removeConnection(std::size_t shard, const std::string &uuid) {
+  auto &target = _shards[shard];
+  auto iter = target._connections.find(uuid);
+  if (iter == target._connections.end()) {
+    return;
+  }
+  for (const auto &room : iter->second->getRooms()) {
+    if (auto members = target._rooms.find(room); members != target._rooms.end()) {
+      members->second.erase(iter->second);
+      if (members->second.empty()) {
+        target._rooms.erase(members);
+      }
+    }
+  }
+  auto [wire_out, wire_in] = iter->second->wireBytes();
+  compressionMetrics.on_close(wire_out, wire_in);
+  target._connections.erase(iter);
+  target._count.store(target._connections.size(), std::memory_order_relaxed);
 }
 
+void ConnectionMgr::joinRoom(const std::shared_ptr<Connection> &conn, const std::string &room) {
+  if (_shards[conn->getShard()]._rooms[room].insert(conn).second) {
+    conn->getRooms().push_back(room);
+  }
+}
 
+void ConnectionMgr::leaveRoom(const std::shared_ptr<Connection> &conn, const std::string &room) {
+  auto &rooms = _shards[conn->getShard()]._rooms;
+  auto members = rooms.find(room);
+  if (members == rooms.end() || members->second.erase(conn) == 0) {
+    return;
+  }
+  if (members->second.empty()) {
+    rooms.erase(members);
+  }
+  std::erase(conn->getRooms(), room);
+}
 
+void ConnectionMgr::broadcast(const std::string &room, MessagePtr message) {
+  for (std::size_t i = 0; i < _shard_count; ++i) {
+    boost::asio::post(_pool->getIoContext(i), [this, i, room, message]() -> void {
+      auto members = _shards[i]._rooms.find(room);
+      if (members == _shards[i]._rooms.end()) {
+        return;
+      }
+      for (const auto &conn : members->second) {
+        conn->asyncSend(message);
+      }
+    });
+  }
+}
+
+void ConnectionMgr::clear() {
+  for (std::size_t i = 0; i < _shard_count; ++i) {
+    _shards[i]._rooms.clear();
+    _shards[i]._connections.clear();
+    _shards[i]._count.store(0, std::memory_order_relaxed);
+  }
+}
+
+void ConnectionMgr::sampleWireBytes() {
+  for (std::size_t i = 0; i < _shard_count; ++i) {
+    boost::asio::post(_pool->getIoContext(i), [this, i]() -> void {
+      std::uint64_t out = 0;
+      std::uint64_t in = 0;
+      for (auto &[uuid, conn] : _shards[i]._connections) {
+        auto [conn_out, conn_in] = conn->wireBytes();
+        out += conn_out;
+        in += conn_in;
+      }
+      _shards[i]._wire_out.store(out, std::memory_order_relaxed);
+      _shards[i]._wire_in.store(in, std::memory_order_relaxed);
+    });
+  }
+}
+
+std::pair<std::uint64_t, std::uint64_t> ConnectionMgr::wireBytes() const {
+  std::pair<std::uint64_t, std::uint64_t> total{0, 0};
+  for (std::size_t i = 0; i < _shard_count; ++i) {
+    total.first += _shards[i]._wire_out.load(std::memory_order_relaxed);
+    total.second += _shards[i]._wire_in.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+std::size_t ConnectionMgr::size() const {
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < _shard_count; ++i) {
+    total += _shards[i]._count.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+/**
+  * @brief 每个io_context一个监听socket(SO_REUSEPORT)，由内核分配新连接，连接此后固定在该线程上
+  * @details 不支持SO_REUSEPORT时只有一个监听socket，接受后轮询分配到各个io_context
+  **/
 class WebSocketServer {
 public:
-  WebSocketServer(boost::asio::io_context &ioc, const boost::asio::ip::tcp::endpoint &endpoint)
-    : _ioc(ioc), _acceptor(ioc, endpoint) {
-    std::print("WebSocket server started on port {}\n", endpoint.port());
-    startAccept();
+  WebSocketServer(IoPool &pool, const boost::asio::ip::tcp::endpoint &endpoint, const DeflateConfig &deflate)
+    : _pool(pool), _deflate(deflate.option()) {
+#ifdef SO_REUSEPORT
+    const std::size_t acceptors = _pool.size();
+#else
+    const std::size_t acceptors = 1;
+#endif
+    _acceptors.reserve(acceptors);
+    for (std::size_t i = 0; i < acceptors; ++i) {
+      listen(_acceptors.emplace_back(_pool.getIoContext(i)), endpoint);
+    }
+    std::print("WebSocket server started on port {} with {} threads\n", endpoint.port(), _pool.size());
+    for (std::size_t i = 0; i < acceptors; ++i) {
+      startAccept(i);
+    }
   }
 
-  void startAccept() {
-    auto conn = std::make_shared<Connection>(_ioc);
-    _acceptor.async_accept(conn->getSocket(),
-      [this, conn](boost::beast::error_code errc) {
+  void startAccept(std::size_t index) {
+#ifdef SO_REUSEPORT
+    const std::size_t shard = index;
+#else
+    const std::size_t shard = _next.fetch_add(1, std::memory_order_relaxed) % _pool.size();
+#endif
+    auto conn = std::make_shared<Connection>(_pool.getIoContext(shard), shard);
+    _acceptors[index].async_accept(conn->getSocket(),
+      [this, index, conn](boost::beast::error_code errc) {
         if (!errc) {
-          conn->asyncAccept();
+          conn->asyncAccept(_deflate);
         } else {
           std::print("accept error, error is: {}\n", errc.message());
         }
-        startAccept();
+        startAccept(index);
       });
   }
 
 private:
-  boost::asio::io_context &_ioc;
-  boost::asio::ip::tcp::acceptor _acceptor;
+  IoPool &_pool;
+  boost::beast::websocket::permessage_deflate _deflate;
+  std::vector<boost::asio::ip::tcp::acceptor> _acceptors;
+  std::atomic<std::size_t> _next{0};
 };
 
-int main() {
+// 每个连接占一个文件描述符，默认的软限制(通常1024)远不够，启动时提到硬限制
+void raise_fd_limit() {
+#ifndef _WIN32
+  rlimit limit{};
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+  getrlimit(RLIMIT_NOFILE, &limit);
+  std::print("max open files: {}\n", limit.rlim_cur);
+#endif
+}
+
+void report_stats(boost::asio::steady_timer &timer) {
+  timer.expires_after(std::chrono::seconds(STATS_INTERVAL_SEC));
+  timer.async_wait([&timer](const boost::system::error_code &ec) -> void {
+    if (ec) {
+      return;
+    }
+    std::print("online connections: {}\n", ConnectionMgr::getInstance().size());
+    auto [wire_out, wire_in] = ConnectionMgr::getInstance().wireBytes();
+    compressionMetrics.report(wire_out, wire_in);
+    ConnectionMgr::getInstance().sampleWireBytes();
+    report_stats(timer);
+  });
+}
+
+// 用法: server [线程数] [deflate=1] [window_bits=12] [server_no_context_takeover=0] [client_no_context_takeover=0] [min_size=64]
+int main(int argc, char *argv[]) {
   try {
-    boost::asio::io_context ioc;
+    raise_fd_limit();
+    const unsigned int threads = argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : std::thread::hardware_concurrency();
+    DeflateConfig deflate;
+    for (int i = 2; i < argc; ++i) {
+      if (!deflate.parse(argv[i])) {
+        std::print("unknown option: {}\n", argv[i]);
+        return EXIT_FAILURE;
+      }
+    }
+    deflate.print();
+    IoPool pool{threads == 0 ? 1 : threads};
+    ConnectionMgr::getInstance().init(pool);
     boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::any(), 10088);
 
-    boost::asio::signal_set signals(ioc, SIGINT, SIGTERM);
-    signals.async_wait([&ioc](const boost::system::error_code &ec, int signal) -> void {
+    boost::asio::signal_set signals(pool.getIoContext(0), SIGINT, SIGTERM);
+    signals.async_wait([&pool](const boost::system::error_code &ec, int signal) -> void {
       if (!ec) {
         std::print("Received signal {}, stopping server...\n", signal);
-        ioc.stop();
+        pool.stop();
       } else {
         std::print("Error waiting for signal: {}\n", ec.message());
       }
     });
 
-    WebSocketServer server(ioc, endpoint);
+    WebSocketServer server(pool, endpoint, deflate);
+    boost::asio::steady_timer stats_timer(pool.getIoContext(0));
+    report_stats(stats_timer);
 
-    ioc.run();
+    pool.run();
+    ConnectionMgr::getInstance().clear();
   } catch (const std::exception &e) {
     std::print("Exception: {}\n", e.what());
   }
-}
\ No newline at end of file
+}
@@ -0,0 +1,64 @@
+#include "HelloClient.hpp"
+
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+
+#include <algorithm>
+#include <print>
+#include <utility>
+
+ChannelPool::ChannelPool(const std::string &target, std::size_t size) {
+  for (std::size_t i = 0; i < std::max<std::size_t>(size, 1); ++i) {
+    grpc::ChannelArguments args;
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    auto &channel = _channels.emplace_back(grpc::CreateCustomChannel(target, grpc::InsecureChannelCredentials(), args));
+    _stubs.push_back(hello::HelloEndpoint::NewStub(channel));
+  }
+}
+
+hello::HelloEndpoint::Stub &ChannelPool::NextStub() {
+  return *_stubs[_next.fetch_add(1, std::memory_order_relaxed) % _stubs.size()];
+}
+
+HelloClient::HelloClient(const std::string &target, std::size_t channels) : _pool(target, channels) {}
+
+std::string HelloClient::SayHello(const std::string &name, std::chrono::milliseconds deadline) {
+  hello::HelloRequest request;
+  request.set_req(name);
+
+  // 响应对象
+  hello::HelloResponse response;
+
+  // 创建上下文，超过截止时间后调用以DEADLINE_EXCEEDED失败
+  grpc::ClientContext context;
+  context.set_deadline(std::chrono::system_clock::now() + deadline);
+
+  // 调用远程方法
+  grpc::Status status = _pool.NextStub().SayHello(&context, request, &response);
+
+  if (status.ok()) {
+    return response.rsp();
+  }
+  std::print("RPC failed: {}\n", status.error_message());
+  return "";
+}
+
+void HelloClient::AsyncSayHello(const std::string &name, Callback callback, std::chrono::milliseconds deadline) {
+  // 上下文和消息需要存活到回调执行，随调用一起分配，回调结束时释放
+  struct Call {
+    grpc::ClientContext _context;
+    hello::HelloRequest _request;
+    hello::HelloResponse _response;
+    Callback _callback;
+  };
+
+  auto *call = new Call();
+  call->_request.set_req(name);
+  call->_callback = std::move(callback);
+  call->_context.set_deadline(std::chrono::system_clock::now() + deadline);
+
+  _pool.NextStub().async()->SayHello(&call->_context, &call->_request, &call->_response, [call](grpc::Status status) -> void {
+    call->_callback(status, call->_response);
+    delete call;
+  });
+}
@@ -0,0 +1,70 @@
+#ifndef HELLOCLIENT_HPP
+#define HELLOCLIENT_HPP
+
+#include "demo.grpc.pb.h"
+
+#include <grpcpp/grpcpp.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 通道池中的通道数，每个通道一条独立的HTTP/2连接
+#define CLIENT_CHANNEL_COUNT 4
+// 未指定时每个调用的超时时间
+#define CLIENT_DEFAULT_DEADLINE_MS 1000
+
+/**
+  * @brief 通道池，按轮询把调用分散到多条HTTP/2连接上
+  * @details 单条连接受服务端并发流上限和连接级流量控制窗口的限制，一个大消息或慢流会拖住同连接上的其它调用；
+  *          相同参数的通道默认共享底层子通道(同一条TCP连接)，这里为每个通道启用本地子通道池，保证连接真正独立
+  **/
+class ChannelPool {
+public:
+  ChannelPool(const std::string &target, std::size_t size);
+
+  // 轮询取下一个通道对应的stub，stub线程安全，可以被多个调用同时使用
+  hello::HelloEndpoint::Stub &NextStub();
+
+  [[nodiscard]] std::size_t Size() const {
+    return _stubs.size();
+  }
+
+private:
+  std::vector<std::shared_ptr<grpc::Channel>> _channels;
+  std::vector<std::unique_ptr<hello::HelloEndpoint::Stub>> _stubs;
+  std::atomic<std::size_t> _next{0};
+};
+
+class HelloClient {
+public:
+  // 回调在gRPC的内部线程上执行，不要在其中阻塞
+  using Callback = std::function<void(const grpc::Status &, const hello::HelloResponse &)>;
+
+  HelloClient(const std::string &target, std::size_t channels = CLIENT_CHANNEL_COUNT);
+
+  // 同步调用，失败时返回空字符串并打印错误
+  std::string SayHello(const std::string &name, std::chrono::milliseconds deadline = std::chrono::milliseconds(CLIENT_DEFAULT_DEADLINE_MS));
+
+  // 回调式异步调用，立即返回，不占用调用线程
+  void AsyncSayHello(const std::string &name, Callback callback,
+                     std::chrono::milliseconds deadline = std::chrono::milliseconds(CLIENT_DEFAULT_DEADLINE_MS));
+
+  // 流式调用直接使用生成的stub，同样按轮询分散到各个通道
+  hello::HelloEndpoint::Stub &NextStub() {
+    return _pool.NextStub();
+  }
+
+  [[nodiscard]] std::size_t Channels() const {
+    return _pool.Size();
+  }
+
+private:
+  ChannelPool _pool;
+};
+
+#endif // HELLOCLIENT_HPP
@@ -1,57 +1,206 @@
-#include "demo.grpc.pb.h"
-#include "demo.pb.h"
+#include "HelloClient.hpp"
 
-#include <grpcpp/channel.h>
-#include <grpcpp/create_channel.h>
-#include <grpcpp/grpcpp.h>
-#include <grpcpp/support/status.h>
-#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
-class DemoClient {
-public:
-  DemoClient(std::shared_ptr<grpc::Channel> channel)
-    : _stub(hello::HelloEndpoint::NewStub(channel)) {}
+// 压测时最多同时在途的调用数，超出的调用直接计为丢弃，避免服务端跟不上时客户端无限堆积
+#define BENCH_MAX_INFLIGHT 10000
 
-  std::string SayHello(const std::string& name) {
-    hello::HelloRequest request;
-    request.set_req(name);
+using Clock = std::chrono::steady_clock;
 
-    // 响应对象
-    hello::HelloResponse response;
+void RunClient(const std::string &target) {
+  // 创建客户端
+  HelloClient client(target, 1);
 
-    // 创建上下文
-    grpc::ClientContext context;
+  std::string reply = client.SayHello("chulan");
+  if (!reply.empty()) {
+    std::print("Server replied: {}\n", reply);
+  } else {
+    std::print("Failed to get a valid response from server.\n");
+  }
+}
+
+double percentile(const std::vector<std::int64_t> &sorted, double pct) {
+  return sorted.empty() ? 0.0 : static_cast<double>(sorted[static_cast<std::size_t>(pct * static_cast<double>(sorted.size() - 1))]);
+}
 
-    // 调用远程方法
-    grpc::Status status = _stub->SayHello(&context, request, &response);
+/**
+  * @brief 按固定速率发起异步调用，统计延迟分位数
+  * @details 开环压测: 第i个调用的计划发送时刻为 start + i/qps，延迟从计划时刻算起，
+  *          发送线程落后时延迟里包含排队时间，不会因为服务端变慢而少发请求、掩盖尾延迟
+  **/
+void RunBench(const std::string &target, int qps, int seconds, std::size_t channels, std::chrono::milliseconds deadline) {
+  HelloClient client(target, channels);
 
-    if (status.ok()) {
-      return response.rsp();
-    } else {
-      std::cerr << "RPC failed: " << status.error_message() << std::endl;
-      return "";
+  // 预热: 每个通道先完成一次调用，把建连时间排除在统计之外
+  for (std::size_t i = 0; i < channels; ++i) {
+    client.SayHello("warmup", std::chrono::seconds(5));
+  }
+
+  const auto total = static_cast<std::size_t>(qps) * static_cast<std::size_t>(seconds);
+  const auto interval = std::chrono::nanoseconds(1'000'000'000LL / qps);
+  // 每个调用只写自己的槽位，-1表示失败或被丢弃
+  std::vector<std::int64_t> latencies_us(total, -1);
+  std::atomic<std::size_t> inflight{0};
+  std::atomic<std::size_t> failed{0};
+  std::atomic<std::size_t> deadline_exceeded{0};
+  std::size_t dropped = 0;
+
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < total; ++i) {
+    const auto scheduled = start + interval * static_cast<std::int64_t>(i);
+    if (Clock::now() < scheduled) {
+      std::this_thread::sleep_until(scheduled);
     }
+    if (inflight.load() >= BENCH_MAX_INFLIGHT) {
+      ++dropped;
+      continue;
+    }
+    inflight.fetch_add(1);
+    client.AsyncSayHello("bench", [&, i, scheduled](const grpc::Status &status, const hello::HelloResponse &) -> void {
+      if (status.ok()) {
+        latencies_us[i] = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - scheduled).count();
+      } else if (status.error_code() == grpc::StatusCode::DEADLINE_EXCEEDED) {
+        deadline_exceeded.fetch_add(1);
+      } else {
+        failed.fetch_add(1);
+      }
+      inflight.fetch_sub(1);
+    }, deadline);
+  }
+  while (inflight.load() > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
   }
+  const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
 
-private:
-  std::unique_ptr<hello::HelloEndpoint::Stub> _stub;
-};
+  std::vector<std::int64_t> sorted;
+  sorted.reserve(total);
+  std::copy_if(latencies_us.begin(), latencies_us.end(), std::back_inserter(sorted), [](std::int64_t us) -> bool { return us >= 0; });
+  std::sort(sorted.begin(), sorted.end());
 
-void RunClient() {
-  // 创建 rpc 通道
-  auto channel = grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials());
+  std::print("target {} qps over {} channels, {} s: sent {}, ok {}, deadline exceeded {}, failed {}, dropped {}\n",
+             qps, client.Channels(), seconds, total - dropped, sorted.size(), deadline_exceeded.load(), failed.load(), dropped);
+  std::print("achieved {:.0f} qps, latency p50: {:.0f} us, p90: {:.0f} us, p99: {:.0f} us, p99.9: {:.0f} us, max: {:.0f} us\n",
+             static_cast<double>(sorted.size()) / elapsed, percentile(sorted, 0.50), percentile(sorted, 0.90), percentile(sorted, 0.99),
+             percentile(sorted, 0.999), sorted.empty() ? 0.0 : static_cast<double>(sorted.back()));
+}
 
-  // 创建客户端
-  DemoClient client(channel);
+void ReportRecords(std::string_view name, Clock::time_point start, std::size_t records, const grpc::Status &status) {
+  const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  std::print("{:<14} {:>9} records in {:>7.3f} s, {:>10.0f} records/s{}\n", name, records, elapsed,
+             static_cast<double>(records) / elapsed, status.ok() ? "" : ", error: " + status.error_message());
+}
 
-  std::string reply = client.SayHello("chulan");
-  if (!reply.empty()) {
-    std::cout << "Server replied: " << reply << std::endl;
-  } else {
-    std::cout << "Failed to get a valid response from server." << std::endl;
+/**
+  * @brief 同一条连接上分别用一元调用和三种流式调用传输一批小记录，比较每秒记录数
+  * @details 一元调用保持inflight个在途，每条记录都要付出一次HTTP/2流的建立、头部和状态的开销；
+  *          流式调用只在开始和结束时付出一次，中间每条记录只是一个DATA帧。服务端流下发的记录由服务端生成
+  **/
+void RunStreamBench(const std::string &target, std::size_t records, std::size_t record_bytes, std::size_t inflight) {
+  HelloClient client(target, 1);
+  client.SayHello("warmup", std::chrono::seconds(5));
+
+  hello::HelloRequest record;
+  record.set_req(std::string(record_bytes, 'x'));
+
+  // 一元调用
+  {
+    std::atomic<std::size_t> pending{0};
+    std::atomic<std::size_t> ok{0};
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < records; ++i) {
+      while (pending.load() >= inflight) {
+        std::this_thread::yield();
+      }
+      pending.fetch_add(1);
+      client.AsyncSayHello(record.req(), [&](const grpc::Status &status, const hello::HelloResponse &) -> void {
+        if (status.ok()) {
+          ok.fetch_add(1);
+        }
+        pending.fetch_sub(1);
+      }, std::chrono::seconds(30));
+    }
+    while (pending.load() > 0) {
+      std::this_thread::yield();
+    }
+    ReportRecords("unary", start, ok.load(), grpc::Status::OK);
+  }
+
+  // 客户端流: Write在消息交给传输层后返回，受服务端的流量控制窗口约束
+  {
+    grpc::ClientContext context;
+    hello::HelloResponse summary;
+    const auto start = Clock::now();
+    auto writer = client.NextStub().SayHelloClientStream(&context, &summary);
+    std::size_t sent = 0;
+    while (sent < records && writer->Write(record)) {
+      ++sent;
+    }
+    writer->WritesDone();
+    ReportRecords("client-stream", start, sent, writer->Finish());
+  }
+
+  // 服务端流
+  {
+    grpc::ClientContext context;
+    hello::HelloRequest request;
+    request.set_req(std::to_string(records));
+    hello::HelloResponse response;
+    const auto start = Clock::now();
+    auto reader = client.NextStub().SayHelloServerStream(&context, request);
+    std::size_t received = 0;
+    while (reader->Read(&response)) {
+      ++received;
+    }
+    ReportRecords("server-stream", start, received, reader->Finish());
+  }
+
+  // 双向流: 写在单独的线程上，与读取同时进行
+  {
+    grpc::ClientContext context;
+    hello::HelloResponse response;
+    const auto start = Clock::now();
+    auto stream = client.NextStub().SayHelloBidiStream(&context);
+    std::jthread writer([&]() -> void {
+      for (std::size_t i = 0; i < records && stream->Write(record); ++i) {
+      }
+      stream->WritesDone();
+    });
+    std::size_t received = 0;
+    while (stream->Read(&response)) {
+      ++received;
+    }
+    writer.join();
+    ReportRecords("bidi-stream", start, received, stream->Finish());
   }
 }
 
-int main() {
-  RunClient();
-}
\ No newline at end of file
+// 用法: client1 [目标地址]
+//       client1 bench [QPS] [秒数] [通道数] [超时毫秒] [目标地址]
+//       client1 stream [记录数] [每条记录字节数] [一元调用并发数] [目标地址]
+int main(int argc, char *argv[]) {
+  if (argc > 1 && std::string_view{argv[1]} == "stream") {
+    const auto records = static_cast<std::size_t>(std::max(1, argc > 2 ? std::atoi(argv[2]) : 100000));
+    const auto record_bytes = static_cast<std::size_t>(std::max(0, argc > 3 ? std::atoi(argv[3]) : 64));
+    const auto inflight = static_cast<std::size_t>(std::max(1, argc > 4 ? std::atoi(argv[4]) : 256));
+    RunStreamBench(argc > 5 ? argv[5] : "localhost:50051", records, record_bytes, inflight);
+    return 0;
+  }
+  if (argc > 1 && std::string_view{argv[1]} == "bench") {
+    const int qps = std::max(1, argc > 2 ? std::atoi(argv[2]) : 10000);
+    const int seconds = std::max(1, argc > 3 ? std::atoi(argv[3]) : 10);
+    const auto channels = static_cast<std::size_t>(std::max(1, argc > 4 ? std::atoi(argv[4]) : CLIENT_CHANNEL_COUNT));
+    const std::chrono::milliseconds deadline{argc > 5 ? std::atoi(argv[5]) : CLIENT_DEFAULT_DEADLINE_MS};
+    RunBench(argc > 6 ? argv[6] : "localhost:50051", qps, seconds, channels, deadline);
+    return 0;
+  }
+  RunClient(argc > 1 ? argv[1] : "localhost:50051");
+}
@@ -1,88 +0,0 @@
-// Generated by the gRPC C++ plugin.
-// If you make any local change, they will be lost.
-// source: demo.proto
-
-#include "demo.pb.h"
-#include "demo.grpc.pb.h"
-
-#include <functional>
-#include <grpcpp/support/async_stream.h>
-#include <grpcpp/support/async_unary_call.h>
-#include <grpcpp/impl/channel_interface.h>
-#include <grpcpp/impl/client_unary_call.h>
-#include <grpcpp/support/client_callback.h>
-#include <grpcpp/support/message_allocator.h>
-#include <grpcpp/support/method_handler.h>
-#include <grpcpp/impl/rpc_service_method.h>
-#include <grpcpp/support/server_callback.h>
-#include <grpcpp/impl/server_callback_handlers.h>
-#include <grpcpp/server_context.h>
-#include <grpcpp/impl/service_type.h>
-#include <grpcpp/support/sync_stream.h>
-#include <grpcpp/ports_def.inc>
-namespace hello {
-
-static const char* HelloEndpoint_method_names[] = {
-  "/hello.HelloEndpoint/SayHello",
-};
-
-std::unique_ptr< HelloEndpoint::Stub> HelloEndpoint::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
-  (void)options;
-  std::unique_ptr< HelloEndpoint::Stub> stub(new HelloEndpoint::Stub(channel, options));
-  return stub;
-}
-
-HelloEndpoint::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options)
-  : channel_(channel), rpcmethod_SayHello_(HelloEndpoint_method_names[0], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
-  {}
-
-::grpc::Status HelloEndpoint::Stub::SayHello(::grpc::ClientContext* context, const ::hello::HelloRequest& request, ::hello::HelloResponse* response) {
-  return ::grpc::internal::BlockingUnaryCall< ::hello::HelloRequest, ::hello::HelloResponse, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(channel_.get(), rpcmethod_SayHello_, context, request, response);
-}
-
-void HelloEndpoint::Stub::async::SayHello(::grpc::ClientContext* context, const ::hello::HelloRequest* request, ::hello::HelloResponse* response, std::function<void(::grpc::Status)> f) {
-  ::grpc::internal::CallbackUnaryCall< ::hello::HelloRequest, ::hello::HelloResponse, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(stub_->channel_.get(), stub_->rpcmethod_SayHello_, context, request, response, std::move(f));
-}
-
-void HelloEndpoint::Stub::async::SayHello(::grpc::ClientContext* context, const ::hello::HelloRequest* request, ::hello::HelloResponse* response, ::grpc::ClientUnaryReactor* reactor) {
-  ::grpc::internal::ClientCallbackUnaryFactory::Create< ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(stub_->channel_.get(), stub_->rpcmethod_SayHello_, context, request, response, reactor);
-}
-
-::grpc::ClientAsyncResponseReader< ::hello::HelloResponse>* HelloEndpoint::Stub::PrepareAsyncSayHelloRaw(::grpc::ClientContext* context, const ::hello::HelloRequest& request, ::grpc::CompletionQueue* cq) {
-  return ::grpc::internal::ClientAsyncResponseReaderHelper::Create< ::hello::HelloResponse, ::hello::HelloRequest, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(channel_.get(), cq, rpcmethod_SayHello_, context, request);
-}
-
-::grpc::ClientAsyncResponseReader< ::hello::HelloResponse>* HelloEndpoint::Stub::AsyncSayHelloRaw(::grpc::ClientContext* context, const ::hello::HelloRequest& request, ::grpc::CompletionQueue* cq) {
-  auto* result =
-    this->PrepareAsyncSayHelloRaw(context, request, cq);
-  result->StartCall();
-  return result;
-}
-
-HelloEndpoint::Service::Service() {
-  AddMethod(new ::grpc::internal::RpcServiceMethod(
-      HelloEndpoint_method_names[0],
-      ::grpc::internal::RpcMethod::NORMAL_RPC,
-      new ::grpc::internal::RpcMethodHandler< HelloEndpoint::Service, ::hello::HelloRequest, ::hello::HelloResponse, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(
-          [](HelloEndpoint::Service* service,
-             ::grpc::ServerContext* ctx,
-             const ::hello::HelloRequest* req,
-             ::hello::HelloResponse* resp) {
-               return service->SayHello(ctx, req, resp);
-             }, this)));
-}
-
-HelloEndpoint::Service::~Service() {
-}
-
-::grpc::Status HelloEndpoint::Service::SayHello(::grpc::ServerContext* context, const ::hello::HelloRequest* request, ::hello::HelloResponse* response) {
-  (void) context;
-  (void) request;
-  (void) response;
-  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
-}
-
-
-}  // namespace hello
-#include <grpcpp/ports_undef.inc>
-
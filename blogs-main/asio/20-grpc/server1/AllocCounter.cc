@@ -0,0 +1,137 @@
+#include "AllocCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <format>
+#include <new>
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+std::atomic<std::uint64_t> g_bytes{0};
+std::atomic<std::uint64_t> g_calls{0};
+
+} // namespace
+
+void AllocCounter::AddCall() {
+#if ALLOC_COUNTER_ENABLED
+  g_calls.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+AllocStats AllocCounter::Snapshot() {
+  return AllocStats{
+      g_allocations.load(std::memory_order_relaxed),
+      g_bytes.load(std::memory_order_relaxed),
+      g_calls.load(std::memory_order_relaxed),
+  };
+}
+
+std::string AllocCounter::Report(const AllocStats &since) {
+#if ALLOC_COUNTER_ENABLED
+  const AllocStats now = Snapshot();
+  const std::uint64_t calls = now._calls - since._calls;
+  const std::uint64_t allocations = now._allocations - since._allocations;
+  const std::uint64_t bytes = now._bytes - since._bytes;
+  if (calls == 0) {
+    return std::format("{} allocations, {} bytes, no calls", allocations, bytes);
+  }
+  return std::format("{} calls, {:.2f} allocations and {:.1f} bytes per call", calls,
+                     static_cast<double>(allocations) / static_cast<double>(calls),
+                     static_cast<double>(bytes) / static_cast<double>(calls));
+#else
+  static_cast<void>(since);
+  return "counter disabled, configure with -DALLOC_COUNTER=ON";
+#endif
+}
+
+#if ALLOC_COUNTER_ENABLED
+
+namespace {
+
+void *CountedAlloc(std::size_t size) noexcept {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_bytes.fetch_add(size, std::memory_order_relaxed);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+// 编译选项关闭了异常，分配失败时无法抛出bad_alloc，直接终止
+void *CheckedAlloc(std::size_t size) {
+  void *ptr = CountedAlloc(size);
+  if (ptr == nullptr) {
+    std::abort();
+  }
+  return ptr;
+}
+
+void *CountedAlignedAlloc(std::size_t size, std::align_val_t align) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_bytes.fetch_add(size, std::memory_order_relaxed);
+  const auto alignment = static_cast<std::size_t>(align);
+  // aligned_alloc要求大小是对齐值的整数倍
+  void *ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+  if (ptr == nullptr) {
+    std::abort();
+  }
+  return ptr;
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  return CheckedAlloc(size);
+}
+
+void *operator new[](std::size_t size) {
+  return CheckedAlloc(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAlloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAlloc(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  return CountedAlignedAlloc(size, align);
+}
+
+void *operator new[](std::size_t size, std::align_val_t align) {
+  return CountedAlignedAlloc(size, align);
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+#endif // ALLOC_COUNTER_ENABLED
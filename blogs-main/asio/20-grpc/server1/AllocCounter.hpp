@@ -0,0 +1,36 @@
+#ifndef ALLOCCOUNTER_HPP
+#define ALLOCCOUNTER_HPP
+
+#include <cstdint>
+#include <string>
+
+// 为1时替换全局operator new/delete，统计进程内的分配次数和字节数，用于比较每次调用的分配开销；
+// 由CMake选项ALLOC_COUNTER打开，默认关闭，计数本身会在多线程间争用同一组原子量，不应混进吞吐和延迟的测量
+#ifndef ALLOC_COUNTER_ENABLED
+#define ALLOC_COUNTER_ENABLED 0
+#endif
+
+// 某一时刻的累计值，报告时取两次快照的差
+struct AllocStats {
+  std::uint64_t _allocations{0};
+  std::uint64_t _bytes{0};
+  std::uint64_t _calls{0};
+};
+
+/**
+  * @brief 内置的分配计数器
+  * @details 只统计经由operator new的分配(protobuf消息、std::string、gRPC C++层的对象)，
+  *          gRPC核心层直接调用gpr_malloc的部分不在其中；计数用relaxed原子量，对性能的影响很小但不为零
+  **/
+class AllocCounter {
+public:
+  // 一元调用的处理函数每处理一次调用记一次，作为平均分配数的分母
+  static void AddCall();
+
+  static AllocStats Snapshot();
+
+  // since之后平均每次调用的分配次数和字节数，未启用时只提示如何打开
+  static std::string Report(const AllocStats &since);
+};
+
+#endif // ALLOCCOUNTER_HPP
@@ -0,0 +1,92 @@
+#ifndef ARENAALLOCATOR_HPP
+#define ARENAALLOCATOR_HPP
+
+#include <google/protobuf/arena.h>
+#include <grpcpp/support/message_allocator.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// 每个arena内嵌的初始内存块，请求和响应对象本身放在这里，不再单独向系统申请
+#define ARENA_INITIAL_BLOCK_SIZE 512
+// arena已占用的内存超过该大小时，调用结束后Reset整个arena，否则只清空内容保留容量
+#define ARENA_REUSE_MAX_BYTES 4096
+// 每个线程最多缓存的空闲arena数
+#define ARENA_POOL_MAX_FREE 256
+
+/**
+  * @brief 回调式服务的消息分配器，请求和响应建在按线程缓存、反复使用的arena上
+  * @details 每个arena带一块内嵌的初始内存，请求和响应对象建在其中；调用结束时消息只清空内容，字符串字段保留容量，
+  *          下一次调用解析请求、填写响应都不再分配；Clear不会归还arena上的内存，
+  *          所以按arena实际占用(SpaceUsed)而不是当前消息大小判断，偏大时才Reset整个arena，避免缓存长期占住大块内存。
+  *          缓存按线程划分，取还都不需要加锁，arena会在分配线程与释放线程之间流动，线程退出时释放自己缓存的部分
+  **/
+template <typename Request, typename Response>
+class ArenaMessageAllocator final : public grpc::MessageAllocator<Request, Response> {
+public:
+  grpc::MessageHolder<Request, Response> *AllocateMessages() override {
+    auto &free = FreeList();
+    Holder *holder = nullptr;
+    if (free.empty()) {
+      holder = new Holder();
+    } else {
+      holder = free.back();
+      free.pop_back();
+    }
+    return holder;
+  }
+
+private:
+  class Holder final : public grpc::MessageHolder<Request, Response> {
+  public:
+    Holder() : _arena(_block.data(), _block.size()) {
+      Create();
+    }
+
+    // 调用结束时由gRPC调用，可能与分配不在同一线程
+    void Release() override {
+      if (_arena.SpaceUsed() > ARENA_REUSE_MAX_BYTES) {
+        _arena.Reset();
+        Create();
+      } else {
+        this->request()->Clear();
+        this->response()->Clear();
+      }
+
+      auto &free = FreeList();
+      if (free.size() < ARENA_POOL_MAX_FREE) {
+        free.push_back(this);
+      } else {
+        delete this;
+      }
+    }
+
+  private:
+    // New(arena)在各个protobuf版本中都会把arena传给消息，字段随之建在arena上
+    void Create() {
+      this->set_request(Request::default_instance().New(&_arena));
+      this->set_response(Response::default_instance().New(&_arena));
+    }
+
+    alignas(std::max_align_t) std::array<char, ARENA_INITIAL_BLOCK_SIZE> _block;
+    google::protobuf::Arena _arena;
+  };
+
+  struct FreeHolders {
+    std::vector<Holder *> _holders;
+
+    ~FreeHolders() {
+      for (Holder *holder : _holders) {
+        delete holder;
+      }
+    }
+  };
+
+  static std::vector<Holder *> &FreeList() {
+    thread_local FreeHolders free;
+    return free._holders;
+  }
+};
+
+#endif // ARENAALLOCATOR_HPP
@@ -0,0 +1,677 @@
+#include "AsyncServer.hpp"
+#include "HelloHandler.hpp"
+#include "LogicSystem.hpp"
+#include "demo.grpc.pb.h"
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/security/server_credentials.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <mutex>
+#include <optional>
+#include <print>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// 完成队列上的事件标签，事件到达时由完成队列线程推进状态
+class Tag {
+public:
+  virtual ~Tag() = default;
+  virtual void Proceed(bool ok) = 0;
+};
+
+// 各类调用对象在池中分开存放
+enum class CallKind : std::uint8_t { SayHello, ClientStream, ServerStream, BidiStream, Count };
+
+class CqWorker;
+
+// 调用对象的公共部分，对象本身就是主标签；ServerContext不能复用，每次用完销毁
+class CallBase : public Tag {
+public:
+  CallBase(CqWorker &worker, CallKind kind) : _worker(worker), _kind(kind) {}
+
+  // 向服务登记一个等待中的调用
+  virtual void Request() = 0;
+
+  // 调用结束后清空状态，消息只清空内容，字符串的容量保留
+  virtual void Reset() = 0;
+
+  [[nodiscard]] CallKind Kind() const {
+    return _kind;
+  }
+
+protected:
+  CqWorker &_worker;
+  std::optional<grpc::ServerContext> _ctx;
+
+private:
+  CallKind _kind;
+};
+
+/**
+  * @brief 把处理函数投递到LogicSystem的逻辑线程执行，处理函数返回的状态由逻辑线程直接Finish
+  * @details Finish可以在任意线程调用，完成事件仍然回到调用所属的完成队列，由该队列的线程回收调用对象；
+  *          逻辑系统已停止时直接回复UNAVAILABLE
+  **/
+template <typename Call, typename Handler>
+void PostToLogic(Call &call, Handler handler) {
+  bool posted = logicSystem.PostTask([&call, handler = std::move(handler)]() -> void {
+    call.Finish(handler(call.request(), &call.response()));
+  });
+  if (!posted) {
+    call.Finish(grpc::Status{grpc::StatusCode::UNAVAILABLE, "logic system stopped"});
+  }
+}
+
+// 一个完成队列及其轮询线程，调用对象池只在本队列的线程上访问
+class CqWorker {
+public:
+  CqWorker(hello::HelloEndpoint::AsyncService &service, std::unique_ptr<grpc::ServerCompletionQueue> cq, AsyncServer::Dispatch dispatch)
+      : _service(service), _cq(std::move(cq)), _dispatch(dispatch) {}
+
+  ~CqWorker() {
+    for (auto &free : _free) {
+      for (CallBase *call : free) {
+        delete call;
+      }
+    }
+  }
+
+  // 从池中取一个调用对象，向服务登记一个等待中的调用
+  template <typename Call>
+  void Spawn() {
+    std::lock_guard<std::mutex> lock{_spawn_mutex};
+    if (_b_stop) {
+      return;
+    }
+    auto &free = _free[static_cast<std::size_t>(Call::kKind)];
+    CallBase *call = nullptr;
+    if (free.empty()) {
+      call = new Call(*this);
+    } else {
+      call = free.back();
+      free.pop_back();
+    }
+    call->Request();
+  }
+
+  // 调用结束，清空后放回池中
+  void Recycle(CallBase *call) {
+    call->Reset();
+    auto &free = _free[static_cast<std::size_t>(call->Kind())];
+    if (free.size() < ASYNC_CALL_POOL_MAX_FREE) {
+      free.push_back(call);
+    } else {
+      delete call;
+    }
+  }
+
+  void Run() {
+    _thread = std::jthread([this]() -> void {
+      void *tag = nullptr;
+      bool ok = false;
+      while (_cq->Next(&tag, &ok)) {
+        static_cast<Tag *>(tag)->Proceed(ok);
+      }
+    });
+  }
+
+  // 关闭完成队列，此后不再登记新调用，线程取完剩余事件后退出
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock{_spawn_mutex};
+      _b_stop = true;
+    }
+    _cq->Shutdown();
+  }
+
+  void Join() {
+    if (_thread.joinable()) {
+      _thread.join();
+    }
+  }
+
+  hello::HelloEndpoint::AsyncService &Service() {
+    return _service;
+  }
+
+  grpc::ServerCompletionQueue *Cq() {
+    return _cq.get();
+  }
+
+  [[nodiscard]] AsyncServer::Dispatch Dispatch() const {
+    return _dispatch;
+  }
+
+private:
+  hello::HelloEndpoint::AsyncService &_service;
+  std::unique_ptr<grpc::ServerCompletionQueue> _cq;
+  AsyncServer::Dispatch _dispatch;
+  std::array<std::vector<CallBase *>, static_cast<std::size_t>(CallKind::Count)> _free;
+
+  // 保证完成队列关闭之后不会再登记调用，只有本队列线程和关闭时的线程会争用
+  std::mutex _spawn_mutex;
+  bool _b_stop{false};
+
+  std::jthread _thread;
+};
+
+class SayHelloCall final : public CallBase {
+public:
+  static constexpr CallKind kKind = CallKind::SayHello;
+
+  explicit SayHelloCall(CqWorker &worker) : CallBase(worker, kKind) {}
+
+  void Request() override {
+    _state = State::Request;
+    _ctx.emplace();
+    _responder.emplace(&*_ctx);
+    _worker.Service().RequestSayHello(&*_ctx, &_request, &*_responder, _worker.Cq(), _worker.Cq(), this);
+  }
+
+  void Proceed(bool ok) override {
+    if (_state == State::Request) {
+      // 服务器关闭时登记中的调用以ok为false返回
+      if (!ok) {
+        _worker.Recycle(this);
+        return;
+      }
+      // 先补上一个等待中的调用，再处理当前调用
+      _worker.Spawn<SayHelloCall>();
+      _state = State::Finish;
+      if (_worker.Dispatch() == AsyncServer::Dispatch::Logic) {
+        PostToLogic(*this, SayHello);
+      } else {
+        Finish(SayHello(_request, &_response));
+      }
+      return;
+    }
+    // Finish完成，ok为false表示客户端已断开，都不需要再处理
+    _worker.Recycle(this);
+  }
+
+  void Finish(const grpc::Status &status) {
+    _responder->Finish(_response, status, this);
+  }
+
+  void Reset() override {
+    _responder.reset();
+    _ctx.reset();
+    _request.Clear();
+    _response.Clear();
+  }
+
+  [[nodiscard]] const hello::HelloRequest &request() const {
+    return _request;
+  }
+
+  hello::HelloResponse &response() {
+    return _response;
+  }
+
+private:
+  enum class State { Request, Finish };
+
+  State _state{State::Request};
+  std::optional<grpc::ServerAsyncResponseWriter<hello::HelloResponse>> _responder;
+  hello::HelloRequest _request;
+  hello::HelloResponse _response;
+};
+
+/**
+  * @brief 流式调用的公共部分: 通过AsyncNotifyWhenDone尽早得知调用被取消
+  * @details Write完成只说明消息交给了传输层，对端取消之后仍可能连续成功很多次，不能只靠写失败来发现断开；
+  *          调用开始后完成通知必定到达一次(调用没开始则不会到达)，调用对象要等完成通知和Finish都回来才能回收
+  **/
+class StreamCallBase : public CallBase {
+public:
+  StreamCallBase(CqWorker &worker, CallKind kind) : CallBase(worker, kind), _done_tag(*this) {}
+
+protected:
+  // 在登记调用之前调用
+  void NotifyWhenDone() {
+    _ctx->AsyncNotifyWhenDone(&_done_tag);
+  }
+
+  // 调用被取消时在完成队列线程上回调，之后的读写都会失败
+  virtual void OnCancelled() = 0;
+
+  void OnFinished() {
+    _finished = true;
+    MaybeRecycle();
+  }
+
+  [[nodiscard]] bool Cancelled() const {
+    return _cancelled;
+  }
+
+  void ResetStream() {
+    _done = false;
+    _finished = false;
+    _cancelled = false;
+  }
+
+private:
+  class DoneTag final : public Tag {
+  public:
+    explicit DoneTag(StreamCallBase &call) : _call(call) {}
+
+    void Proceed(bool) override {
+      _call._done = true;
+      _call._cancelled = _call._ctx->IsCancelled();
+      if (_call._cancelled && !_call._finished) {
+        _call.OnCancelled();
+      }
+      _call.MaybeRecycle();
+    }
+
+  private:
+    StreamCallBase &_call;
+  };
+
+  void MaybeRecycle() {
+    if (_done && _finished) {
+      _worker.Recycle(this);
+    }
+  }
+
+  DoneTag _done_tag;
+  bool _done{false};
+  bool _finished{false};
+  bool _cancelled{false};
+};
+
+/**
+  * @brief 客户端流: 逐条读取记录，客户端结束写入后回复一次汇总
+  * @details 任何时刻只挂一个Read，应用不读时gRPC不再向对端发放流量控制窗口，客户端的写入自然被限速
+  **/
+class ClientStreamCall final : public StreamCallBase {
+public:
+  static constexpr CallKind kKind = CallKind::ClientStream;
+
+  explicit ClientStreamCall(CqWorker &worker) : StreamCallBase(worker, kKind) {}
+
+  void Request() override {
+    _state = State::Request;
+    _ctx.emplace();
+    _reader.emplace(&*_ctx);
+    NotifyWhenDone();
+    _worker.Service().RequestSayHelloClientStream(&*_ctx, &*_reader, _worker.Cq(), _worker.Cq(), this);
+  }
+
+  void Proceed(bool ok) override {
+    switch (_state) {
+    case State::Request:
+      // 服务器关闭时登记中的调用以ok为false返回，此时不会有完成通知
+      if (!ok) {
+        _worker.Recycle(this);
+        return;
+      }
+      _worker.Spawn<ClientStreamCall>();
+      _state = State::Read;
+      _reader->Read(&_request, this);
+      return;
+    case State::Read:
+      if (ok) {
+        ++_records;
+        _bytes += _request.req().size();
+        _reader->Read(&_request, this);
+        return;
+      }
+      // 客户端已结束写入(或已断开)
+      _response.set_rsp(std::format("Server1 received {} records, {} bytes", _records, _bytes));
+      _state = State::Finish;
+      _reader->Finish(_response, Cancelled() ? grpc::Status::CANCELLED : grpc::Status::OK, this);
+      return;
+    case State::Finish:
+      OnFinished();
+      return;
+    }
+  }
+
+  void Reset() override {
+    _reader.reset();
+    _ctx.reset();
+    _request.Clear();
+    _response.Clear();
+    _records = 0;
+    _bytes = 0;
+    ResetStream();
+  }
+
+private:
+  enum class State { Request, Read, Finish };
+
+  // 取消后挂着的Read会以失败返回，在那里结束
+  void OnCancelled() override {}
+
+  State _state{State::Request};
+  std::optional<grpc::ServerAsyncReader<hello::HelloResponse, hello::HelloRequest>> _reader;
+  hello::HelloRequest _request;
+  hello::HelloResponse _response;
+  std::uint64_t _records{0};
+  std::uint64_t _bytes{0};
+};
+
+/**
+  * @brief 服务端流: 请求中给出记录数，逐条写回
+  * @details 上一条Write完成后才发下一条，完成事件只有在消息进入传输层后才到达，服务端不会堆积未发送的消息；
+  *          每次写之前检查取消标记，客户端走掉后立即停止；最后一条与状态合并发送
+  **/
+class ServerStreamCall final : public StreamCallBase {
+public:
+  static constexpr CallKind kKind = CallKind::ServerStream;
+
+  explicit ServerStreamCall(CqWorker &worker) : StreamCallBase(worker, kKind) {}
+
+  void Request() override {
+    _state = State::Request;
+    _ctx.emplace();
+    _writer.emplace(&*_ctx);
+    NotifyWhenDone();
+    _worker.Service().RequestSayHelloServerStream(&*_ctx, &_request, &*_writer, _worker.Cq(), _worker.Cq(), this);
+  }
+
+  void Proceed(bool ok) override {
+    switch (_state) {
+    case State::Request: {
+      if (!ok) {
+        _worker.Recycle(this);
+        return;
+      }
+      _worker.Spawn<ServerStreamCall>();
+      const std::string &req = _request.req();
+      std::from_chars(req.data(), req.data() + req.size(), _total);
+      _total = std::min<std::uint64_t>(_total, STREAM_MAX_RECORDS);
+      WriteNext(true);
+      return;
+    }
+    case State::Write:
+      WriteNext(ok);
+      return;
+    case State::Finish:
+      OnFinished();
+      return;
+    }
+  }
+
+  void Reset() override {
+    _writer.reset();
+    _ctx.reset();
+    _request.Clear();
+    _response.Clear();
+    _total = 0;
+    _sent = 0;
+    ResetStream();
+  }
+
+private:
+  enum class State { Request, Write, Finish };
+
+  // 挂着的Write完成后在WriteNext中检查取消标记
+  void OnCancelled() override {}
+
+  void WriteNext(bool ok) {
+    if (!ok || Cancelled()) {
+      _state = State::Finish;
+      _writer->Finish(grpc::Status::CANCELLED, this);
+      return;
+    }
+    if (_sent == _total) {
+      _state = State::Finish;
+      _writer->Finish(grpc::Status::OK, this);
+      return;
+    }
+    _response.set_rsp(std::format("Server1 record {}", _sent));
+    if (++_sent == _total) {
+      _state = State::Finish;
+      _writer->WriteAndFinish(_response, grpc::WriteOptions(), grpc::Status::OK, this);
+      return;
+    }
+    _state = State::Write;
+    _writer->Write(_response, this);
+  }
+
+  State _state{State::Request};
+  std::optional<grpc::ServerAsyncWriter<hello::HelloResponse>> _writer;
+  hello::HelloRequest _request;
+  hello::HelloResponse _response;
+  std::uint64_t _total{0};
+  std::uint64_t _sent{0};
+};
+
+/**
+  * @brief 双向流: 每收到一条记录回复一条，读写各挂一个操作，互不等待
+  * @details 待发送的回复放在固定大小的环形缓冲中，缓冲满时暂停读取，写出腾出位置后再恢复，
+  *          对端读得慢时背压沿着流量控制窗口传回对端的写入端；读写完成事件都在本完成队列线程上，不需要加锁
+  **/
+class BidiStreamCall final : public StreamCallBase {
+public:
+  static constexpr CallKind kKind = CallKind::BidiStream;
+
+  explicit BidiStreamCall(CqWorker &worker) : StreamCallBase(worker, kKind), _write_tag(*this) {}
+
+  void Request() override {
+    _state = State::Request;
+    _ctx.emplace();
+    _stream.emplace(&*_ctx);
+    NotifyWhenDone();
+    _worker.Service().RequestSayHelloBidiStream(&*_ctx, &*_stream, _worker.Cq(), _worker.Cq(), this);
+  }
+
+  // 主标签承载登记、读取和Finish三种事件，Finish只在没有在途读写时发出，不会混淆
+  void Proceed(bool ok) override {
+    if (_state == State::Request) {
+      if (!ok) {
+        _worker.Recycle(this);
+        return;
+      }
+      _worker.Spawn<BidiStreamCall>();
+      _state = State::Stream;
+      StartRead();
+      return;
+    }
+    if (_state == State::Finish) {
+      OnFinished();
+      return;
+    }
+
+    _reading = false;
+    if (!ok) {
+      _reads_done = true;
+    } else {
+      auto &reply = _pending[(_head + _count) % _pending.size()];
+      BuildReply(_request, &reply);
+      ++_count;
+      StartWrite();
+      if (_count < _pending.size()) {
+        StartRead();
+      }
+    }
+    MaybeFinish();
+  }
+
+  void Reset() override {
+    _stream.reset();
+    _ctx.reset();
+    _request.Clear();
+    for (auto &reply : _pending) {
+      reply.Clear();
+    }
+    _head = 0;
+    _count = 0;
+    _reading = false;
+    _writing = false;
+    _reads_done = false;
+    ResetStream();
+  }
+
+private:
+  enum class State { Request, Stream, Finish };
+
+  class WriteTag final : public Tag {
+  public:
+    explicit WriteTag(BidiStreamCall &call) : _call(call) {}
+
+    void Proceed(bool ok) override {
+      _call.OnWriteDone(ok);
+    }
+
+  private:
+    BidiStreamCall &_call;
+  };
+
+  // 不再发起新的读写，挂着的操作会以失败返回
+  void OnCancelled() override {
+    MaybeFinish();
+  }
+
+  void StartRead() {
+    if (_reading || _reads_done || Cancelled()) {
+      return;
+    }
+    _reading = true;
+    _stream->Read(&_request, this);
+  }
+
+  void StartWrite() {
+    if (_writing || _count == 0 || Cancelled()) {
+      return;
+    }
+    _writing = true;
+    _stream->Write(_pending[_head], &_write_tag);
+  }
+
+  void OnWriteDone(bool ok) {
+    _writing = false;
+    if (!ok) {
+      // 写失败说明流已经断开，让挂着的读取尽快返回
+      _ctx->TryCancel();
+      _reads_done = true;
+    } else {
+      _head = (_head + 1) % _pending.size();
+      --_count;
+      StartWrite();
+      StartRead();
+    }
+    MaybeFinish();
+  }
+
+  void MaybeFinish() {
+    if (_reading || _writing || _state != State::Stream) {
+      return;
+    }
+    const bool broken = Cancelled() || (_reads_done && _count > 0);
+    if (!broken && !(_reads_done && _count == 0)) {
+      return;
+    }
+    _state = State::Finish;
+    _stream->Finish(broken ? grpc::Status::CANCELLED : grpc::Status::OK, this);
+  }
+
+  State _state{State::Request};
+  std::optional<grpc::ServerAsyncReaderWriter<hello::HelloResponse, hello::HelloRequest>> _stream;
+  WriteTag _write_tag;
+  hello::HelloRequest _request;
+  std::array<hello::HelloResponse, STREAM_MAX_PENDING_WRITES> _pending;
+  std::size_t _head{0};
+  std::size_t _count{0};
+  bool _reading{false};
+  bool _writing{false};
+  bool _reads_done{false};
+};
+
+} // namespace
+
+struct AsyncServer::_impl {
+  std::string _address;
+  std::size_t _cq_count;
+  Dispatch _dispatch;
+
+  hello::HelloEndpoint::AsyncService _service;
+  std::unique_ptr<grpc::Server> _server;
+  std::vector<std::unique_ptr<CqWorker>> _workers;
+
+  _impl(std::string address, std::size_t cq_count, Dispatch dispatch)
+      : _address(std::move(address)), _cq_count(cq_count), _dispatch(dispatch) {}
+};
+
+AsyncServer::AsyncServer(std::string address, std::size_t cq_count, Dispatch dispatch)
+    : _pimpl(std::make_unique<_impl>(std::move(address), cq_count, dispatch)) {
+  if (_pimpl->_cq_count == 0) {
+    _pimpl->_cq_count = std::max(1U, std::thread::hardware_concurrency());
+  }
+}
+
+AsyncServer::~AsyncServer() {
+  Shutdown();
+}
+
+bool AsyncServer::Start() {
+  grpc::ServerBuilder builder;
+  builder.AddListeningPort(_pimpl->_address, grpc::InsecureServerCredentials());
+  builder.RegisterService(&_pimpl->_service);
+
+  std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> cqs;
+  for (std::size_t i = 0; i < _pimpl->_cq_count; ++i) {
+    cqs.push_back(builder.AddCompletionQueue());
+  }
+
+  _pimpl->_server = builder.BuildAndStart();
+  if (!_pimpl->_server) {
+    return false;
+  }
+
+  for (auto &cq : cqs) {
+    auto &worker = _pimpl->_workers.emplace_back(std::make_unique<CqWorker>(_pimpl->_service, std::move(cq), _pimpl->_dispatch));
+    for (int i = 0; i < ASYNC_PENDING_CALLS_PER_CQ; ++i) {
+      worker->Spawn<SayHelloCall>();
+    }
+    // 流式调用通常是少量长连接，各挂几个即可
+    for (int i = 0; i < ASYNC_PENDING_STREAMS_PER_CQ; ++i) {
+      worker->Spawn<ClientStreamCall>();
+      worker->Spawn<ServerStreamCall>();
+      worker->Spawn<BidiStreamCall>();
+    }
+    worker->Run();
+  }
+
+  std::print("Async server listening on {}, completion queues: {}, dispatch: {}\n", _pimpl->_address, _pimpl->_cq_count,
+             _pimpl->_dispatch == Dispatch::Logic ? "logic" : "inline");
+  return true;
+}
+
+void AsyncServer::Shutdown() {
+  if (!_pimpl->_server) {
+    return;
+  }
+
+  // 先停止服务，超时后在途调用被取消；再停逻辑线程，保证之后不会有Finish落到已关闭的完成队列上
+  _pimpl->_server->Shutdown(std::chrono::system_clock::now() + std::chrono::milliseconds(ASYNC_SHUTDOWN_TIMEOUT_MS));
+  if (_pimpl->_dispatch == Dispatch::Logic) {
+    logicSystem.Stop();
+  }
+
+  for (auto &worker : _pimpl->_workers) {
+    worker->Stop();
+  }
+  for (auto &worker : _pimpl->_workers) {
+    worker->Join();
+  }
+
+  // 与gRPC示例一致，先销毁服务器，再销毁完成队列
+  _pimpl->_server.reset();
+  _pimpl->_workers.clear();
+}
+
+std::size_t AsyncServer::CqCount() const {
+  return _pimpl->_cq_count;
+}
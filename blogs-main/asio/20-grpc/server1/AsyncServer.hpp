@@ -0,0 +1,55 @@
+#ifndef ASYNCSERVER_HPP
+#define ASYNCSERVER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// 完成队列数，0表示取CPU核数，每个完成队列由一个专属线程轮询
+#define ASYNC_CQ_COUNT 0
+// 每个完成队列上预先挂起等待新请求的调用数，决定能同时接入多少个新调用
+#define ASYNC_PENDING_CALLS_PER_CQ 64
+// 每个完成队列上每种流式方法预先挂起的调用数
+#define ASYNC_PENDING_STREAMS_PER_CQ 4
+// 每个完成队列最多缓存的每种空闲调用对象数
+#define ASYNC_CALL_POOL_MAX_FREE 1024
+// 服务端流单次最多下发的记录数
+#define STREAM_MAX_RECORDS 10000000
+// 双向流中待发送回复的上限，达到后暂停读取，直到写出腾出位置
+#define STREAM_MAX_PENDING_WRITES 64
+// 关闭时等待在途调用完成的时间，超时后直接取消
+#define ASYNC_SHUTDOWN_TIMEOUT_MS 1000
+
+/**
+  * @brief 基于完成队列的异步gRPC服务器
+  * @details 启动N个完成队列，每个由一个线程轮询；调用对象在各自完成队列的线程上取还，
+  *          不需要加锁，请求/响应消息清空后保留已分配的容量供下次复用。
+  *          一个调用只在事件到达时短暂占用完成队列线程，不再像同步服务那样每个调用占一个线程。
+  *          消息是池中调用对象的成员，随调用对象整体复用，本身从不逐次分配，所以这里不再建arena:
+  *          arena省掉的正是消息对象和字段的逐次分配，池化之后已经没有这部分；callback模式的消息由gRPC按调用分配，才需要ArenaMessageAllocator
+  **/
+class AsyncServer {
+public:
+  // 一元调用处理函数的执行位置: 直接在完成队列线程上执行，或者投递到LogicSystem的逻辑线程；流式调用总在完成队列线程上处理
+  enum class Dispatch { Inline, Logic };
+
+  AsyncServer(std::string address, std::size_t cq_count, Dispatch dispatch);
+  ~AsyncServer();
+
+  AsyncServer(const AsyncServer &) = delete;
+  AsyncServer &operator=(const AsyncServer &) = delete;
+
+  // 监听端口失败返回false
+  bool Start();
+
+  // 停止接收新调用，等待在途调用完成后退出所有完成队列线程
+  void Shutdown();
+
+  [[nodiscard]] std::size_t CqCount() const;
+
+private:
+  struct _impl;
+  std::unique_ptr<_impl> _pimpl;
+};
+
+#endif // ASYNCSERVER_HPP
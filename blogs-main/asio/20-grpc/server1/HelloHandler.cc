@@ -0,0 +1,16 @@
+#include "HelloHandler.hpp"
+#include "AllocCounter.hpp"
+
+#include <string>
+
+void BuildReply(const hello::HelloRequest &request, hello::HelloResponse *response) {
+  std::string *rsp = response->mutable_rsp();
+  rsp->assign("Server1 response: ");
+  rsp->append(request.req());
+}
+
+grpc::Status SayHello(const hello::HelloRequest &request, hello::HelloResponse *response) {
+  AllocCounter::AddCall();
+  BuildReply(request, response);
+  return grpc::Status::OK;
+}
@@ -0,0 +1,14 @@
+#ifndef HELLOHANDLER_HPP
+#define HELLOHANDLER_HPP
+
+#include "demo.pb.h"
+
+#include <grpcpp/support/status.h>
+
+// 在响应的字段里原地拼接回复，字段已有容量时不再分配；先拼出临时字符串再set_rsp会多一次分配，并丢掉字段原有的容量
+void BuildReply(const hello::HelloRequest &request, hello::HelloResponse *response);
+
+// 各种服务模型共用的SayHello处理函数，每次调用计入AllocCounter的调用数
+grpc::Status SayHello(const hello::HelloRequest &request, hello::HelloResponse *response);
+
+#endif // HELLOHANDLER_HPP
@@ -0,0 +1,59 @@
+#include "LogicSystem.hpp"
+
+#include <utility>
+
+LogicSystem::LogicSystem() {
+  _worker_thread = std::jthread([this]() -> void {
+    while (true) {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock{_queue_mutex};
+        _queue_cv.wait(lock, [this]() -> bool {
+          return !_task_queue.empty() || _b_stop;
+        });
+
+        // 停止后仍然处理完剩余的任务
+        if (_task_queue.empty()) {
+          break;
+        }
+        task = std::move(_task_queue.front());
+        _task_queue.pop();
+        _queue_size.store(_task_queue.size(), std::memory_order_relaxed);
+      }
+      task();
+    }
+  });
+}
+
+LogicSystem::~LogicSystem() {
+  Stop();
+}
+
+bool LogicSystem::PostTask(Task task) {
+  std::lock_guard<std::mutex> lock{_queue_mutex};
+  if (_b_stop) {
+    return false;
+  }
+  _task_queue.push(std::move(task));
+  _queue_size.store(_task_queue.size(), std::memory_order_relaxed);
+
+  if (_task_queue.size() == 1) {
+    _queue_cv.notify_one();
+  }
+  return true;
+}
+
+std::size_t LogicSystem::QueueSize() const {
+  return _queue_size.load(std::memory_order_relaxed);
+}
+
+void LogicSystem::Stop() {
+  {
+    std::lock_guard<std::mutex> lock{_queue_mutex};
+    _b_stop = true;
+  }
+  _queue_cv.notify_one();
+  if (_worker_thread.joinable()) {
+    _worker_thread.join();
+  }
+}
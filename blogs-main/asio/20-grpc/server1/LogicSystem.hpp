@@ -0,0 +1,53 @@
+#ifndef LOGICSYSTEM_HPP
+#define LOGICSYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+/**
+  * @brief 逻辑系统，与17-coroutine-server中的LogicSystem同一模型: 单个工作线程按投递顺序执行任务
+  * @details 业务状态只在逻辑线程上访问，不需要加锁；RPC处理函数通过PostTask把工作交给这里，
+  *          完成后由逻辑线程直接调用Finish，完成队列线程不会被业务阻塞
+  **/
+class LogicSystem {
+public:
+  using Task = std::function<void()>;
+
+  static LogicSystem &getInstance() {
+    static LogicSystem instance;
+    return instance;
+  }
+
+  LogicSystem(const LogicSystem &) = delete;
+  LogicSystem &operator=(const LogicSystem &) = delete;
+
+  // 逻辑系统已停止时返回false，任务不会执行
+  bool PostTask(Task task);
+
+  // 当前逻辑队列中待处理的任务数
+  [[nodiscard]] std::size_t QueueSize() const;
+
+  // 处理完已投递的任务后退出工作线程，之后投递的任务被丢弃
+  void Stop();
+
+private:
+  LogicSystem();
+  ~LogicSystem();
+
+  std::mutex _queue_mutex;
+  std::condition_variable _queue_cv;
+  std::queue<Task> _task_queue;
+  std::atomic<std::size_t> _queue_size{0};
+  bool _b_stop{false};
+
+  std::jthread _worker_thread;
+};
+
+#define logicSystem LogicSystem::getInstance()
+
+#endif // LOGICSYSTEM_HPP
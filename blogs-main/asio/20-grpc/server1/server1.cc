@@ -1,3 +1,7 @@
+#include "AllocCounter.hpp"
+#include "ArenaAllocator.hpp"
+#include "AsyncServer.hpp"
+#include "HelloHandler.hpp"
 #include "demo.grpc.pb.h"
 
 #include <grpcpp/grpcpp.h>
@@ -6,29 +10,121 @@
 
 #include <print>
 #include <memory>
+#include <string_view>
+#include <cstdlib>
+#include <thread>
+#include <chrono>
+
+#ifndef _WIN32
+#include <csignal>
+#endif
 
 class DemoServiceImpl final : public hello::HelloEndpoint::Service {
 public:
-  grpc::Status SayHello(grpc::ServerContext* context, const hello::HelloRequest* request, hello::HelloResponse* response) {
-    response->set_rsp("Server1 response: " + request->req());
-    return grpc::Status::OK;
+  grpc::Status SayHello(grpc::ServerContext* /*context*/, const hello::HelloRequest* request, hello::HelloResponse* response) {
+    return ::SayHello(*request, response);
+  }
+};
+
+// 回调式服务: 处理函数在gRPC的回调线程上执行，请求和响应由服务上设置的消息分配器提供
+class CallbackServiceImpl final : public hello::HelloEndpoint::CallbackService {
+public:
+  grpc::ServerUnaryReactor *SayHello(grpc::CallbackServerContext *context, const hello::HelloRequest *request,
+                                     hello::HelloResponse *response) override {
+    grpc::ServerUnaryReactor *reactor = context->DefaultReactor();
+    reactor->Finish(::SayHello(*request, response));
+    return reactor;
   }
 };
 
-void startServer() {
-  std::string server_address("0.0.0.0:50051");
+const std::string server_address("0.0.0.0:50051");
+
+#ifndef _WIN32
+sigset_t shutdownSignals() {
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  return signals;
+}
+#endif
+
+// 在启动任何线程之前屏蔽退出信号，所有线程继承该掩码，信号只由主线程的sigwait接收
+void blockSignals() {
+#ifndef _WIN32
+  sigset_t signals = shutdownSignals();
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+#endif
+}
+
+void waitForSignal() {
+#ifndef _WIN32
+  sigset_t signals = shutdownSignals();
+  int signal = 0;
+  sigwait(&signals, &signal);
+  std::print("Received signal {}, shutting down\n", signal);
+#else
+  std::this_thread::sleep_until(std::chrono::steady_clock::time_point::max());
+#endif
+}
+
+// 同步服务与回调式服务: 处理函数都在gRPC内部的线程上执行，启动和关闭方式相同
+int startServer(grpc::Service &service) {
+  blockSignals();
 
   grpc::ServerBuilder builder;
   builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
-
-  DemoServiceImpl service;
   builder.RegisterService(&service);
 
   std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
+  if (!server) {
+    std::print("Failed to listen on {}\n", server_address);
+    return 1;
+  }
   std::print("Server listening on {}\n", server_address);
-  server->Wait();
+
+  const AllocStats since = AllocCounter::Snapshot();
+  waitForSignal();
+  std::print("Allocations: {}\n", AllocCounter::Report(since));
+  server->Shutdown();
+  return 0;
+}
+
+// 异步服务: 完成队列线程推进调用状态，阻塞等待退出信号后关闭
+int startAsyncServer(std::size_t cq_count, AsyncServer::Dispatch dispatch) {
+  blockSignals();
+
+  AsyncServer server{server_address, cq_count, dispatch};
+  if (!server.Start()) {
+    std::print("Failed to listen on {}\n", server_address);
+    return 1;
+  }
+
+  const AllocStats since = AllocCounter::Snapshot();
+  waitForSignal();
+  std::print("Allocations: {}\n", AllocCounter::Report(since));
+  server.Shutdown();
+  return 0;
 }
 
-int main() {
-  startServer();
-}
\ No newline at end of file
+// 用法: server1 [sync|callback|arena|async|logic] [完成队列数]
+// sync和callback由gRPC的线程执行处理函数，arena在callback的基础上把请求和响应建在按线程复用的arena上；
+// async在完成队列线程上直接处理，logic把处理函数投递到LogicSystem的逻辑线程；退出时打印每次一元调用的平均分配数
+int main(int argc, char *argv[]) {
+  std::string_view mode = argc > 1 ? argv[1] : "async";
+  const auto cq_count = static_cast<std::size_t>(argc > 2 ? std::atoi(argv[2]) : ASYNC_CQ_COUNT);
+
+  if (mode == "sync") {
+    DemoServiceImpl service;
+    return startServer(service);
+  }
+  if (mode == "callback" || mode == "arena") {
+    CallbackServiceImpl service;
+    ArenaMessageAllocator<hello::HelloRequest, hello::HelloResponse> allocator;
+    if (mode == "arena") {
+      service.SetMessageAllocatorFor_SayHello(&allocator);
+    }
+    return startServer(service);
+  }
+  return startAsyncServer(cq_count, mode == "logic" ? AsyncServer::Dispatch::Logic : AsyncServer::Dispatch::Inline);
+}
@@ -0,0 +1,162 @@
+#include <boost/asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// 对比 thread-per-connection 与固定线程池两种模式
+// 用法: bench <server可执行文件> [连接数] [每连接消息数] [空闲长连接数]
+// 依次以两种模式启动服务端，先建立一批一直不发消息的长连接，再用单线程异步客户端同时发起所有连接，
+// 运行期间从 /proc/<pid>/status 采样线程数与常驻内存，结束后由 wait4 取得整个进程
+// (包括已退出线程)的内存峰值与上下文切换次数(仅Linux)
+
+#define MSG_LENGTH 64
+
+using Clock = std::chrono::steady_clock;
+
+struct ProcStat {
+  long _rss_kb{0};
+  long _threads{0};
+};
+
+ProcStat readStat(pid_t pid) {
+  ProcStat stat;
+  std::ifstream file{"/proc/" + std::to_string(pid) + "/status"};
+  std::string key;
+  long value = 0;
+  while (file >> key) {
+    if (key == "VmRSS:" && file >> value) {
+      stat._rss_kb = value;
+    } else if (key == "Threads:" && file >> value) {
+      stat._threads = value;
+    }
+  }
+  return stat;
+}
+
+// 每个连接: connect -> 写一条 -> 读回同样长度 -> 重复 -> 关闭
+class Conn : public std::enable_shared_from_this<Conn> {
+public:
+  Conn(boost::asio::io_context &ioc, int messages, std::atomic<int> &done) : _sock(ioc), _left(messages), _done(done) {
+    std::fill(std::begin(_send), std::end(_send), 'x');
+  }
+
+  void Start(const boost::asio::ip::tcp::endpoint &ep) {
+    _sock.async_connect(ep, [self = shared_from_this()](const boost::system::error_code &err) -> void {
+      if (err) {
+        std::cout << "connect error: " << err.message() << '\n';
+        self->_done.fetch_add(1);
+        return;
+      }
+      self->write();
+    });
+  }
+
+private:
+  void write() {
+    if (_left-- == 0) {
+      boost::system::error_code ec;
+      _sock.close(ec);
+      _done.fetch_add(1);
+      return;
+    }
+    boost::asio::async_write(_sock, boost::asio::buffer(_send), [self = shared_from_this()](const boost::system::error_code &err, std::size_t) -> void {
+      if (!err) {
+        self->read();
+      }
+    });
+  }
+
+  void read() {
+    boost::asio::async_read(_sock, boost::asio::buffer(_recv), [self = shared_from_this()](const boost::system::error_code &err, std::size_t) -> void {
+      if (err) {
+        std::cout << "read error: " << err.message() << '\n';
+        self->_done.fetch_add(1);
+        return;
+      }
+      self->write();
+    });
+  }
+
+  boost::asio::ip::tcp::socket _sock;
+  char _send[MSG_LENGTH];
+  char _recv[MSG_LENGTH];
+  int _left;
+  std::atomic<int> &_done;
+};
+
+void runMode(const char *server_path, const char *mode, int connections, int messages, int idle) {
+  std::cout.flush();
+  pid_t pid = fork();
+  if (pid == 0) {
+    // 服务端的逐条日志不参与对比
+    freopen("/dev/null", "w", stdout);
+    execl(server_path, server_path, mode, static_cast<char *>(nullptr));
+    _exit(1);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  boost::asio::io_context ioc;
+  boost::asio::ip::tcp::endpoint ep{boost::asio::ip::make_address_v4("127.0.0.1"), 10088};
+
+  // 空闲长连接多于工作线程时，按连接占用工作线程的服务端会让后来的连接一直排不上
+  std::vector<boost::asio::ip::tcp::socket> idle_socks;
+  for (int i = 0; i < idle; ++i) {
+    idle_socks.emplace_back(ioc).connect(ep);
+  }
+
+  std::atomic<int> done{0};
+  auto start = Clock::now();
+  for (int i = 0; i < connections; ++i) {
+    std::make_shared<Conn>(ioc, messages, done)->Start(ep);
+  }
+
+  // 运行期间采样线程数峰值
+  std::atomic_bool finished{false};
+  long peak_threads = 0;
+  long peak_rss_kb = 0;
+  std::jthread sampler{[&]() -> void {
+    while (!finished.load()) {
+      ProcStat stat = readStat(pid);
+      peak_threads = std::max(peak_threads, stat._threads);
+      peak_rss_kb = std::max(peak_rss_kb, stat._rss_kb);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }};
+
+  ioc.run();
+  double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+  finished.store(true);
+  sampler.join();
+
+  kill(pid, SIGTERM);
+  rusage usage{};
+  wait4(pid, nullptr, 0, &usage);
+
+  std::cout << mode << "\t" << static_cast<double>(connections) * messages / seconds << "\t" << usage.ru_maxrss << "\t" << peak_rss_kb
+            << "\t" << peak_threads << "\t" << usage.ru_nvcsw + usage.ru_nivcsw << '\n';
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cout << "usage: bench <server> [connections] [messages]\n";
+    return 1;
+  }
+  int connections = argc > 2 ? std::atoi(argv[2]) : 1000;
+  int messages = argc > 3 ? std::atoi(argv[3]) : 100;
+  int idle = argc > 4 ? std::atoi(argv[4]) : 128;
+
+  std::cout << "mode\tmsg/s\tmax rss(kB)\tsampled rss(kB)\tpeak threads\tctx switches\n";
+  runMode(argv[1], "thread", connections, messages, idle);
+  runMode(argv[1], "pool", connections, messages, idle);
+}
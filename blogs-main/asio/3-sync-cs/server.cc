@@ -1,43 +1,149 @@
 #include <boost/asio.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
 #include <cstring>
+#include <format>
 #include <iostream>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <queue>
+#include <string_view>
 #include <thread>
 #include <vector>
 
 #define MAX_LENGTH 1024
+#define POOL_SIZE 64
 
 using PtrSocket = std::shared_ptr<boost::asio::ip::tcp::socket>;
-std::vector<std::shared_ptr<std::jthread>> threads;
 
-void session(PtrSocket sock) {
-  try {
-    for (;;) {
-      char receive[MAX_LENGTH];
-      memset(receive, '\0', MAX_LENGTH);
-      boost::system::error_code ec;
-
-      // 此处我们假设不存在粘包情况，即采用read_some也能读完
-      sock->read_some(boost::asio::buffer(receive, MAX_LENGTH), ec);
-
-      if (ec == boost::asio::error::eof) {
-        std::cout << std::format("connection error: {}\n", ec.message());
-        break;
-      } else if (ec) {
-        throw boost::system::system_error{ec};
-      }
+// 读一次并原样写回，对端关闭时返回false
+bool echoOnce(boost::asio::ip::tcp::socket &sock) {
+  char receive[MAX_LENGTH];
+  boost::system::error_code ec;
+
+  // 此处我们假设不存在粘包情况，即采用read_some也能读完
+  std::size_t length = sock.read_some(boost::asio::buffer(receive, MAX_LENGTH), ec);
+
+  if (ec == boost::asio::error::eof) {
+    std::cout << std::format("connection error: {}\n", ec.message());
+    return false;
+  } else if (ec) {
+    throw boost::system::system_error{ec};
+  }
 
-      std::cout << std::format("Receive from client: {}, message is: {}\n", sock->remote_endpoint().address().to_string(), receive);
+  std::cout << std::format("Receive from client: {}, message is: {}\n", sock.remote_endpoint().address().to_string(),
+                           std::string_view{receive, length});
 
-      // 发送回去
-      boost::asio::write(*sock, boost::asio::buffer(receive, MAX_LENGTH), ec);
+  // 读到多少就发回多少
+  boost::asio::write(sock, boost::asio::buffer(receive, length), ec);
+  if (ec) {
+    throw boost::system::system_error{ec};
+  }
+  return true;
+}
+
+void session(PtrSocket sock) {
+  try {
+    while (echoOnce(*sock)) {
     }
   } catch (const boost::system::system_error &se) {
     std::cout << std::format("error code is: {}, error msg is: {}\n", se.code().value(), se.code().message());
   }
 }
 
-void server(boost::asio::io_context &ioc, unsigned short port) {
+// 每个连接一个线程，结束的连接在下一次accept时回收
+struct Connection {
+  std::atomic_bool _done{false};
+  std::jthread _thread;
+};
+std::list<Connection> connections;
+
+void reap() {
+  connections.remove_if([](const Connection &conn) -> bool {
+    return conn._done.load(std::memory_order_acquire);
+  });
+}
+
+// 固定数量的工作线程，按每次读取分派，而不是按连接
+// 空闲的连接挂在一个等待线程上等待可读，可读后交给工作线程做一次阻塞的读和写，随即重新挂回去；
+// 工作线程不会被某个长连接一直占着，连接数远多于工作线程时也不会有连接排不上队
+class ConnectionPool {
+public:
+  ConnectionPool(boost::asio::io_context &ioc, std::size_t size)
+      : _ioc(ioc), _guard(boost::asio::make_work_guard(ioc)), _watcher([this]() -> void { _ioc.run(); }) {
+    _workers.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      _workers.emplace_back([this](const std::stop_token &stop_token) -> void { work(stop_token); });
+    }
+  }
+
+  ~ConnectionPool() {
+    for (auto &worker : _workers) {
+      worker.request_stop();
+    }
+    _not_empty.notify_all();
+    _guard.reset();
+    _ioc.stop();
+  }
+
+  void Submit(PtrSocket sock) {
+    watch(std::move(sock));
+  }
+
+private:
+  // 同一个socket任一时刻只在等待线程或某个工作线程中的一处，经由_mutex交接，无需额外同步
+  void watch(PtrSocket sock) {
+    auto &socket = *sock;
+    socket.async_wait(boost::asio::ip::tcp::socket::wait_read,
+      [this, sock = std::move(sock)](const boost::system::error_code &ec) mutable -> void {
+        if (ec) {
+          return;
+        }
+        std::lock_guard<std::mutex> lock{_mutex};
+        _readable.emplace(std::move(sock));
+        _not_empty.notify_one();
+      });
+  }
+
+  void work(const std::stop_token &stop_token) {
+    while (!stop_token.stop_requested()) {
+      PtrSocket sock;
+      {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _not_empty.wait(lock, [&]() -> bool { return !_readable.empty() || stop_token.stop_requested(); });
+        if (_readable.empty()) {
+          return;
+        }
+        sock = std::move(_readable.front());
+        _readable.pop();
+      }
+
+      // 数据已经到达，这次阻塞读不会等待；连接结束后socket随之释放
+      try {
+        if (echoOnce(*sock)) {
+          watch(std::move(sock));
+        }
+      } catch (const boost::system::system_error &se) {
+        std::cout << std::format("error code is: {}, error msg is: {}\n", se.code().value(), se.code().message());
+      }
+    }
+  }
+
+  boost::asio::io_context &_ioc;
+
+  std::mutex _mutex;
+  std::condition_variable _not_empty;
+  std::queue<PtrSocket> _readable;
+  std::vector<std::jthread> _workers;
+
+  // 等待线程最后构造、最先停止
+  boost::asio::executor_work_guard<boost::asio::io_context::executor_type> _guard;
+  std::jthread _watcher;
+};
+
+void server(boost::asio::io_context &ioc, unsigned short port, ConnectionPool *pool) {
   boost::asio::ip::tcp::endpoint ep{boost::asio::ip::address_v4::any(), port};
   boost::asio::ip::tcp::acceptor acceptor{ioc, ep};
 
@@ -48,17 +154,35 @@ void server(boost::asio::io_context &ioc, unsigned short port) {
     acceptor.accept(*sock);
 
     // 进入通信
-    auto thr = std::make_shared<std::jthread>(session, sock);
-    threads.emplace_back(thr);
+    if (pool != nullptr) {
+      pool->Submit(std::move(sock));
+      continue;
+    }
+
+    reap();
+    auto &conn = connections.emplace_back();
+    conn._thread = std::jthread([sock, &conn]() -> void {
+      session(sock);
+      conn._done.store(true, std::memory_order_release);
+    });
   }
 }
 
-int main() {
+// 用法: server [thread|pool] [工作线程数]
+int main(int argc, char *argv[]) {
   try {
+    std::string_view mode = argc > 1 ? argv[1] : "thread";
     boost::asio::io_context ioc;
-    server(ioc, 10088);
+    std::unique_ptr<ConnectionPool> pool;
+    if (mode == "pool") {
+      std::size_t size = argc > 2 ? static_cast<std::size_t>(std::atoi(argv[2])) : POOL_SIZE;
+      pool = std::make_unique<ConnectionPool>(ioc, size);
+      std::cout << "Worker pool size: " << size << '\n';
+    }
+
+    server(ioc, 10088, pool.get());
 
   } catch (const boost::system::system_error &se) {
     std::cout << std::format("error code is: {}, error msg is: {}\n", se.code().value(), se.code().message());
   }
-}
\ No newline at end of file
+}